@@ -0,0 +1,65 @@
+/**
+ * @file advice.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines functions for passing the access pattern of I/O batches to the kernel.
+ * @version 1.0
+ * @date 2022-06-19
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_ADVICE_HPP_INCLUDED
+#define FSOP_ADVICE_HPP_INCLUDED
+
+#include <vector>        // std::vector
+
+#include "fsop/file.hpp"
+#include "fsop/batch.hpp" // fsop::Batch, fsop::default_batch_gap
+
+namespace fsop
+{
+    /**
+     * @brief Access patterns recognized over lists of I/O batches.
+     */
+    enum class AccessPattern
+    {
+        /** Batches proceed forward through the file, with small gaps at most. */
+        sequential,
+        /** Batches jump around the file. */
+        random
+    };
+
+    /**
+     * @brief Classifies the access pattern of a list of batches, in the order they are executed.
+     *
+     * @param batches Batches to classify.
+     * @param max_gap Largest gap between consecutive batches still considered sequential, in bytes.
+     * @return {AccessPattern} The access pattern of the batches.
+     */
+    AccessPattern classify_access(const std::vector<Batch>& batches, size_t max_gap = default_batch_gap);
+
+    /**
+     * @brief Advises the kernel of the access pattern of a list of batches over a regular file.
+     *
+     * Sequential batches mark their span as sequential (enlarging readahead) and start reading
+     * the first batch ahead. Random batches disable readahead for the file, and request
+     * exactly the ranges of the batches to be read ahead instead.
+     *
+     * @param file Regular file the batches are executed over.
+     * @param batches Batches to be executed, in order.
+     * @return {AccessPattern} The access pattern advised.
+     */
+    AccessPattern advise_access(File& file, const std::vector<Batch>& batches);
+
+    /**
+     * @brief Drops clean pages of the ranges of a list of batches from the page cache,
+     *  so that large scans do not evict the working set of other processes. Dirty pages
+     *  are not dropped, hence written content should be synced beforehand.
+     *
+     * @param file Regular file the batches were executed over.
+     * @param batches Executed batches.
+     */
+    void drop_cached(File& file, const std::vector<Batch>& batches);
+}
+
+#endif // FSOP_ADVICE_HPP_INCLUDED
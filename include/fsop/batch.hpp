@@ -0,0 +1,95 @@
+/**
+ * @file batch.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines functions for executing lists of I/O batches via vectored system calls.
+ * @version 1.0
+ * @date 2022-06-12
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_BATCH_HPP_INCLUDED
+#define FSOP_BATCH_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <string>      // std::string
+#include <vector>      // std::vector
+#include <string_view> // std::string_view
+
+#include <sys/types.h> // off64_t
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Describes a single I/O batch over an absolute byte range of a file.
+     */
+    struct Batch
+    {
+        /** Byte offset of the range, from the beginning of the file. */
+        off64_t offset;
+        /** Number of bytes spanned by the range. */
+        size_t  nbytes;
+    };
+
+    /** Default for the largest gap between batches which is bridged when reading, in bytes. */
+    inline constexpr size_t default_batch_gap = 4096;
+
+    /**
+     * @brief Reads a list of batches from a file using positional vectored reads.
+     *
+     * Batches are ordered by offset and grouped into runs, where each batch begins at most
+     * max_gap bytes after the end of the previous one. Every run is read via a single
+     * `preadv` call (split only at IOV_MAX regions), with bridged gaps read into a scratch
+     * region which is discarded. Batches need not be given in order, and may overlap.
+     *
+     * @param file File to read content from (must support positional reads).
+     * @param batches Batches to read. Byte counts must be finite (not File::bytes_till_end).
+     * @param buffers Buffers to read content into, resized to one per batch. Each buffer holds
+     *                exactly the bytes read for its batch, which are fewer than requested at EOF.
+     * @param max_gap Largest gap between batches to bridge within a run (default=default_batch_gap).
+     * @return {size_t} Number of system calls issued.
+     *
+     * @throws {std::system_error} reason for failure of operation.
+     */
+    size_t read_batches(
+        File& file, const std::vector<Batch>& batches,
+        std::vector<std::string>& buffers, size_t max_gap = default_batch_gap
+    );
+
+    /**
+     * @brief Writes data to a list of absolute offsets of a file using positional vectored writes.
+     *
+     * Consecutive batches where each begins exactly at the end of the previous one are written
+     * via a single `pwritev` call. Batches are written in the given order, so that overlapping
+     * batches retain the effect of sequential writes.
+     *
+     * @param file File to write content to (must support positional writes).
+     * @param offsets Byte offsets, from the beginning of the file, for each batch.
+     * @param data Content to write for each batch (one per offset).
+     * @param nbytes_written Number of bytes written for each batch, resized to one per batch.
+     * @return {size_t} Number of system calls issued.
+     *
+     * @throws {std::system_error} reason for failure of operation.
+     */
+    size_t write_batches(
+        File& file, const std::vector<off64_t>& offsets,
+        const std::vector<std::string>& data, std::vector<size_t>& nbytes_written
+    );
+
+    /**
+     * @brief Writes a sequence of memory regions to a file at its current offset, using as few
+     *        `writev` calls as possible and resuming after partial writes.
+     *
+     * @param file File to write content to (may be a pipe, such as the standard output).
+     * @param data Content to write, in order.
+     * @return {size_t} Total number of bytes written.
+     *
+     * @throws {std::system_error} reason for failure of operation.
+     */
+    size_t write_vectored(File& file, const std::vector<std::string_view>& data);
+}
+
+#endif // FSOP_BATCH_HPP_INCLUDED
@@ -0,0 +1,95 @@
+/**
+ * @file buffered_file.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines a structure for coalescing small writes to files in a user-space buffer.
+ * @version 1.0
+ * @date 2022-06-15
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_BUFFERED_FILE_HPP_INCLUDED
+#define FSOP_BUFFERED_FILE_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+#include <sys/types.h> // off64_t
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Defines a structure for buffered writes over a file.
+     *
+     * BufferedFile objects collect small writes in a buffer and issue them to the underlying
+     * file in a single system call once the buffer reaches its watermark, when explicitly
+     * flushed, or when the object runs out of scope. Writes at least as large as the watermark
+     * bypass the buffer. The underlying file is referenced, not owned, and must outlive the object.
+     */
+    struct BufferedFile
+    {
+        /** Default watermark of the buffer, in bytes. */
+        static constexpr size_t default_capacity = 1ULL << 16;
+
+        /**
+         * @brief Construct a new BufferedFile object
+         *
+         * @param file File (opened for writing) to write buffered content to.
+         * @param capacity Watermark of the buffer, in bytes: pending content is flushed
+         *                 once it would grow beyond this size.
+         */
+        explicit BufferedFile(File& file, size_t capacity = default_capacity);
+        /** Disallow creation via copy constructor. */
+        BufferedFile(const BufferedFile&) = delete;
+        /** Disallow copy assignment of objects. */
+        BufferedFile& operator=(const BufferedFile&) = delete;
+        /**
+         * @brief Destroy the BufferedFile object, after flushing pending content.
+         *        Failures are ignored at this point; use {flush} to observe them.
+         */
+        ~BufferedFile();
+
+        /**
+         * @brief Writes byte data to the buffer, flushing it when the watermark is reached.
+         *
+         * Moving the offset of the file flushes pending content first, so that content
+         * lands at the same locations as with unbuffered writes.
+         *
+         * @param data Data to write, can be a std::string or a c-string (any type convertible to std::string_view).
+         * @param offset Byte offset to begin writing content to (default=0).
+         * @param whence Offset base for movement reference along the file, can be one of
+         *               SEEK_SET, SEEK_CUR or SEEK_END (default=SEEK_CUR).
+         * @return {size_t} Number of bytes accepted, equal to the size of data.
+         */
+        size_t write(std::string_view data, off64_t offset = 0, int whence = SEEK_CUR);
+        /**
+         * @brief Writes all pending content to the file.
+         *
+         * @return {size_t} Number of bytes written to the file.
+         */
+        size_t flush();
+
+        /** Returns the number of bytes pending in the buffer. */
+        size_t pending () const noexcept { return _buffer.size(); }
+        /** Returns the watermark of the buffer, in bytes. */
+        size_t capacity() const noexcept { return _capacity; }
+        /** Returns the underlying file. */
+        File&  file    () noexcept { return _file; }
+
+    private:
+        /** File to write buffered content to. */
+        File&       _file;
+        /** Watermark of the buffer, in bytes. */
+        size_t      _capacity;
+        /** Content pending to be written. */
+        std::string _buffer;
+    };
+
+    inline constexpr size_t BufferedFile::default_capacity;
+}
+
+#endif // FSOP_BUFFERED_FILE_HPP_INCLUDED
@@ -11,12 +11,27 @@
 #ifndef FSOP_CREATE_HPP_INCLUDED
 #define FSOP_CREATE_HPP_INCLUDED
 
+#include <cstddef>      // std::size_t
+
 #include <string_view>  // std::string_view
 
 #include <sys/types.h>  // mode_t
 
 namespace fsop
 {
+    /**
+     * @brief Ways of allocating the initial content of a regular file.
+     */
+    enum class Allocation
+    {
+        /** Disk blocks are reserved upfront (fallocate), reading back as zeros. */
+        preallocate,
+        /** The size is set without allocating blocks (ftruncate), leaving a hole. */
+        sparse,
+        /** Blocks are allocated by writing zeros over the content. */
+        zero
+    };
+
     /**
      * @brief Creates a new regular file in the filesystem.
      *
@@ -27,10 +42,15 @@ namespace fsop
      * @param path The path at which the file must be created.
      * @param permissions The permissions to associate with the file.
      * @param overwrite If true, recreates the file, effectively truncating previous content.
+     * @param size Initial size of the file, in bytes (default=0).
+     * @param allocation How the initial content of the file is allocated (default=Allocation::preallocate).
      *
      * @throws {std::system_error} reason for failure of operation.
      */
-    void create_file(std::string_view path, mode_t permissions, bool overwrite = false);
+    void create_file(
+        std::string_view path, mode_t permissions, bool overwrite = false,
+        size_t size = 0, Allocation allocation = Allocation::preallocate
+    );
 
     /**
      * @brief Creates a new named pipe (FIFO file) in the filesystem.
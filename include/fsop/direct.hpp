@@ -0,0 +1,169 @@
+/**
+ * @file direct.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines structures and functions for direct I/O (O_DIRECT), bypassing the page cache.
+ * @version 1.0
+ * @date 2022-06-18
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_DIRECT_HPP_INCLUDED
+#define FSOP_DIRECT_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <mutex>       // std::mutex
+#include <vector>      // std::vector
+#include <functional>  // std::function
+#include <string_view> // std::string_view
+
+#include <sys/types.h> // off64_t
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Alignment requirements for direct I/O over a file.
+     */
+    struct DirectAlignment
+    {
+        /** Alignment required for the addresses of buffers, in bytes. */
+        size_t memory;
+        /** Alignment required for file offsets and lengths, in bytes. */
+        size_t offset;
+    };
+
+    /**
+     * @brief Retrieves the alignment requirements for direct I/O over a file, via statx
+     *  (STATX_DIOALIGN). Where the kernel or filesystem does not report them, the preferred
+     *  I/O block size of the file is used, which satisfies the requirements of common devices.
+     *
+     * @param file File to retrieve requirements for.
+     * @return {DirectAlignment} Alignment requirements for direct I/O.
+     */
+    DirectAlignment direct_alignment(File& file);
+
+    /**
+     * @brief Defines a thread-safe pool of equally sized buffers aligned for direct I/O.
+     *
+     * Buffers are leased from the pool and returned to it when the lease runs out of scope,
+     * so that repeated I/O does not allocate. Pools are neither copyable nor movable, and
+     * must outlive the leases taken from them.
+     */
+    struct AlignedBufferPool
+    {
+        /**
+         * @brief A buffer leased from a pool, returned to it on destruction. Leases are move-only.
+         */
+        struct Lease
+        {
+            /** Construct a new Lease object over a buffer of a pool. */
+            Lease(AlignedBufferPool& pool, char* data) : _pool(&pool), _data(data) {}
+            Lease(const Lease&) = delete;
+            Lease(Lease&& tmp_lease) noexcept : _pool(tmp_lease._pool), _data(tmp_lease._data)
+            {
+                tmp_lease._data = nullptr;
+            }
+            Lease& operator=(const Lease&) = delete;
+            Lease& operator=(Lease&&) = delete;
+            /** Destroy the Lease object, returning the buffer to the pool. */
+            ~Lease() { if(_data) _pool->release(_data); }
+
+            /** Returns the address of the buffer. */
+            char*  data() const noexcept { return _data; }
+            /** Returns the size of the buffer, in bytes. */
+            size_t size() const noexcept { return _pool->buffer_size(); }
+
+        private:
+            /** Pool the buffer was leased from. */
+            AlignedBufferPool* _pool;
+            /** Address of the buffer. */
+            char*              _data;
+        };
+
+        /**
+         * @brief Construct a new AlignedBufferPool object
+         *
+         * @param buffer_size Size of each buffer, rounded up to a multiple of the alignment.
+         * @param alignment Alignment of buffer addresses, in bytes (a power of 2).
+         * @param initial_count Number of buffers to allocate upfront (default=2).
+         *                      More are allocated on demand.
+         */
+        AlignedBufferPool(size_t buffer_size, size_t alignment, size_t initial_count = 2);
+        AlignedBufferPool(const AlignedBufferPool&) = delete;
+        AlignedBufferPool& operator=(const AlignedBufferPool&) = delete;
+        /** Destroy the AlignedBufferPool object, freeing all buffers. */
+        ~AlignedBufferPool();
+
+        /**
+         * @brief Leases a buffer from the pool, allocating one if none is free.
+         *
+         * @return {Lease} Lease over the buffer.
+         */
+        Lease  acquire();
+
+        /** Returns the size of each buffer, in bytes. */
+        size_t buffer_size() const noexcept { return _buffer_size; }
+        /** Returns the alignment of buffer addresses, in bytes. */
+        size_t alignment  () const noexcept { return _alignment; }
+
+    private:
+        /** Returns a leased buffer to the pool. */
+        void   release(char* data) noexcept;
+        /** Allocates a new aligned buffer. */
+        char*  allocate();
+
+        /** Size of each buffer, in bytes. */
+        size_t             _buffer_size;
+        /** Alignment of buffer addresses, in bytes. */
+        size_t             _alignment;
+        /** Guards the lists of buffers. */
+        std::mutex         _lock;
+        /** Buffers available for lease. */
+        std::vector<char*> _free;
+        /** All buffers allocated by the pool. */
+        std::vector<char*> _all;
+    };
+
+    /**
+     * @brief Reads a byte range of a file opened with O_DIRECT through aligned buffers.
+     *
+     * The range is widened to block boundaries for the reads, and the unaligned head
+     * and tail are trimmed before content is handed to the consumer, in order.
+     *
+     * @param file File (opened with O_DIRECT) to read content from.
+     * @param pool Pool of buffers aligned as required by the file; determines the size of each read.
+     * @param alignment Alignment requirements of the file, as per {direct_alignment}.
+     * @param consumer Callback receiving each chunk of content, valid only for the duration of the call.
+     * @param offset Byte offset from the beginning of the file to begin reading from.
+     * @param nbytes Number of bytes to read (reads stop early at the end of the file).
+     * @return {size_t} Total number of bytes handed to the consumer.
+     */
+    size_t read_direct(
+        File& file, AlignedBufferPool& pool, const DirectAlignment& alignment,
+        const std::function<void(std::string_view)>& consumer, off64_t offset, size_t nbytes
+    );
+
+    /**
+     * @brief Writes byte data at an offset of a file opened with O_DIRECT through aligned buffers.
+     *
+     * Blocks only partially covered by the data (at an unaligned head or tail) are read,
+     * patched and written back. If the write extends the file, its size is trimmed
+     * back to the end of the data afterwards.
+     *
+     * @param file File (opened with O_DIRECT, for reading and writing) to write content to.
+     * @param pool Pool of buffers aligned as required by the file; determines the size of each write.
+     * @param alignment Alignment requirements of the file, as per {direct_alignment}.
+     * @param data Data to write.
+     * @param offset Byte offset from the beginning of the file to begin writing content to.
+     * @return {size_t} Number of bytes written, equal to the size of data.
+     */
+    size_t write_direct(
+        File& file, AlignedBufferPool& pool, const DirectAlignment& alignment,
+        std::string_view data, off64_t offset
+    );
+}
+
+#endif // FSOP_DIRECT_HPP_INCLUDED
@@ -0,0 +1,90 @@
+/**
+ * @file directory.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines functions for resolving paths relative to cached directory handles.
+ * @version 1.0
+ * @date 2022-06-21
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_DIRECTORY_HPP_INCLUDED
+#define FSOP_DIRECTORY_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <memory>      // std::shared_ptr
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+#include <fcntl.h>     // AT_FDCWD
+
+namespace fsop
+{
+    /**
+     * @brief Describes a path as its leaf component relative to a handle of its parent directory,
+     *  for use with the *at() family of system calls.
+     */
+    struct ResolvedPath
+    {
+        /** Handle of the parent directory, kept open for as long as the object refers to it. */
+        std::shared_ptr<const int> handle;
+        /** Path relative to the parent directory: the leaf component, or the complete path without a handle. */
+        std::string name;
+
+        /**
+         * @brief Returns the descriptor to resolve the name relative to.
+         *
+         * @return {int} Descriptor of the parent directory, or AT_FDCWD without a handle.
+         */
+        int directory() const noexcept { return handle ? *handle : AT_FDCWD; }
+    };
+
+    /** Largest number of directory handles kept open by the cache. */
+    constexpr size_t max_cached_directories = 256;
+
+    /**
+     * @brief Resolves a path into its leaf component and a cached handle of its parent directory.
+     *
+     * Parent directories are opened once (with O_PATH) and cached by their path, so that
+     * later operations on files in the same directory only walk the leaf component. Paths
+     * without a parent component, or with parents which cannot be opened, resolve relative
+     * to the current working directory instead, leaving errors to the operation itself.
+     * Once full, the cache drops its least recently used handle. The cache is thread-safe.
+     *
+     * A cached handle keeps referring to the directory it was opened on, even after that
+     * directory is renamed, or removed and replaced by another at the same path. Such stale
+     * handles are detected by revalidation, which compares the handle against the directory
+     * the parent path currently refers to, at the cost of walking the parent path again.
+     * Operations call {refresh_path} when they fail instead of revalidating upfront, so that
+     * only the leaf component is looked up. Hence an operation through a stale handle which
+     * succeeds (including creating a file) acts in the directory as it was when first resolved.
+     *
+     * @param path Path to resolve.
+     * @param revalidate Whether to check a cached handle against the parent path, replacing it if stale (default=false).
+     * @return {ResolvedPath} The parent directory handle and leaf component of the path.
+     */
+    ResolvedPath resolve_path(std::string_view path, bool revalidate = false);
+
+    /**
+     * @brief Revalidates the parent directory handle of a resolved path after an operation
+     *  through it failed (with ENOENT, ENOTDIR or ESTALE, as set in errno), resolving the
+     *  path again if the handle has gone stale.
+     *
+     * @param resolved Resolved path, updated if its handle was stale.
+     * @param path Path the resolved path was obtained from.
+     * @return {bool} true if the path was resolved again, so that the operation is worth retrying;
+     *  false otherwise, with errno left as set by the failed operation.
+     */
+    bool refresh_path(ResolvedPath& resolved, std::string_view path);
+
+    /**
+     * @brief Drops all cached directory handles. Handles still referred to by
+     *  resolved paths are closed once the last such path is destroyed.
+     *
+     * Must be called whenever the current working directory changes, as relative parent paths are cached.
+     */
+    void clear_directory_cache();
+}
+
+#endif // FSOP_DIRECTORY_HPP_INCLUDED
@@ -0,0 +1,83 @@
+/**
+ * @file extents.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines functions for mapping and reading the data extents of sparse files.
+ * @version 1.0
+ * @date 2022-06-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_EXTENTS_HPP_INCLUDED
+#define FSOP_EXTENTS_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <vector>      // std::vector
+#include <functional>  // std::function
+#include <string_view> // std::string_view
+
+#include <sys/types.h> // off64_t
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Describes a contiguous byte range of a file holding either data or a hole.
+     */
+    struct Extent
+    {
+        /** Byte offset of the range, from the beginning of the file. */
+        off64_t offset;
+        /** Number of bytes spanned by the range. */
+        size_t  nbytes;
+        /** Whether the range holds data (true) or is a hole (false). */
+        bool    data;
+    };
+
+    /**
+     * @brief Maps the data extents and holes of a byte range of a regular file,
+     *  via lseek with SEEK_DATA and SEEK_HOLE. The offset of the file is preserved.
+     *
+     * Filesystems without support for holes report the complete range as data.
+     *
+     * @param file Regular file to map extents of.
+     * @param offset Byte offset to begin mapping from (default=0).
+     * @param nbytes Number of bytes to map, limited to the end of the file (default=File::bytes_till_end).
+     * @return {std::vector<Extent>} Alternating data and hole extents covering the range, in order.
+     */
+    std::vector<Extent> map_extents(File& file, off64_t offset = 0, size_t nbytes = File::bytes_till_end);
+
+    /**
+     * @brief Counts the physical extents allocated on disk for a regular file,
+     *  via the FIEMAP ioctl. Dirty pages are synced first, so that delayed allocations are counted.
+     *
+     * @param file Regular file to count extents of.
+     * @return {size_t} Number of extents mapped for the file (zero for files without allocated blocks).
+     *
+     * @throws {std::system_error} reason for failure of operation, such as EOPNOTSUPP
+     *  for filesystems without support for FIEMAP.
+     */
+    size_t count_extents(File& file);
+
+    /**
+     * @brief Reads a byte range of a regular file, skipping I/O for holes.
+     *
+     * Data extents are read via positional reads in chunks, while holes are synthesized
+     * as chunks of zeros without any system calls. Content is handed to the consumer in order.
+     *
+     * @param file Regular file to read content from.
+     * @param consumer Callback receiving each chunk of content, valid only for the duration of the call.
+     * @param chunk_size Largest number of bytes handed over per chunk.
+     * @param offset Byte offset to begin reading from (default=0).
+     * @param nbytes Number of bytes to read, limited to the end of the file (default=File::bytes_till_end).
+     * @return {size_t} Total number of bytes handed to the consumer.
+     */
+    size_t read_sparse(
+        File& file, const std::function<void(std::string_view)>& consumer, size_t chunk_size,
+        off64_t offset = 0, size_t nbytes = File::bytes_till_end
+    );
+}
+
+#endif // FSOP_EXTENTS_HPP_INCLUDED
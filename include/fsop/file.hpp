@@ -13,16 +13,63 @@
 
 #include <cstddef>     // std::size_t
 
+#include <chrono>      // std::chrono::nanoseconds
+#include <iosfwd>      // std::ostream
+#include <memory>      // std::shared_ptr
 #include <string>      // std::string
+#include <functional>  // std::function
 #include <utility>     // std::pair
 #include <string_view> // std::string_view
 
 #include <fcntl.h>     // O_* constants
+#include <sys/uio.h>   // struct iovec
 #include <sys/stat.h>  // stat64
 #include <sys/types.h> // off64_t
 
 namespace fsop
 {
+    /**
+     * @brief Counters describing the writes issued through File::write_all and File::pwrite_all,
+     *  and the syncs issued through the object (by durability, File::sync and File::sync_data).
+     */
+    struct WriteStats
+    {
+        /** Number of write system calls issued. */
+        size_t calls        = 0;
+        /** Number of bytes written. */
+        size_t bytes        = 0;
+        /** Number of writes which accepted fewer bytes than requested. */
+        size_t short_writes = 0;
+        /** Number of times the writer waited for the file to become writable. */
+        size_t stalls       = 0;
+        /** Number of syncs issued to make written content durable. */
+        size_t syncs        = 0;
+        /** Total time spent waiting for the file to become writable. */
+        std::chrono::nanoseconds stall_time { 0 };
+    };
+
+    /**
+     * @brief Levels of durability maintained by File objects for written content.
+     */
+    enum class Durability
+    {
+        /** Content is left to the kernel to write back. */
+        none,
+        /** Content is synced once a byte count or time interval since the last sync is exceeded. */
+        periodic,
+        /** Content is synced at the end of every batch, when committed via {File::commit}. */
+        batch
+    };
+
+    /**
+     * @brief Prints counters accumulated by full writes to a given output stream, on a single line.
+     *
+     * @param os The output stream to write content to.
+     * @param stats The counters to display.
+     * @return {std::ostream&} Reference to the output stream for cascading operations.
+     */
+    std::ostream& print_write_stats(std::ostream& os, const WriteStats& stats);
+
     /**
      * @brief Defines a structure for abstracting I/O operations via system calls.
      *
@@ -59,7 +106,8 @@ namespace fsop
          *
          * @param file_ref File object reference maintaining a file descriptor.
          *                 The descriptor is duped to increase the effective reference count
-         *                 of the global file table entry.
+         *                 of the global file table entry. The level of durability and sync
+         *                 progress are shared with the referenced object.
          */
         File(const File& file_ref);
         /**
@@ -71,7 +119,8 @@ namespace fsop
          */
         File(File&& tmp_file)
         : _descriptor(tmp_file._descriptor), _info(tmp_file._info),
-          _info_set(tmp_file._info_set)
+          _info_set(tmp_file._info_set), _write_stats(tmp_file._write_stats),
+          _sync(std::move(tmp_file._sync))
         {
             tmp_file._descriptor = invalid_descriptor;
             tmp_file._info_set = false;
@@ -89,7 +138,8 @@ namespace fsop
          *
          * @param file_ref File object reference maintaining a file descriptor.
          *                 The descriptor is duped to increase the effective reference count
-         *                 of the global file table entry.
+         *                 of the global file table entry. The level of durability and sync
+         *                 progress are shared with the referenced object.
          * @return {File&} Reference to the current object, for chaining operations.
          */
         File& operator=(const File& file_ref);
@@ -116,6 +166,85 @@ namespace fsop
          * @return {std::string} A string containing the read content.
          */
         std::string read(size_t nbytes = bytes_till_end, off64_t offset = 0, int whence = SEEK_CUR);
+        /**
+         * @brief Reads data into a caller-supplied string buffer, reusing its allocated capacity.
+         *        Behaves as the string-returning overload, except that the buffer is resized
+         *        to hold exactly the bytes read, so repeated calls with the same buffer avoid
+         *        allocations once the buffer has grown to the largest batch size.
+         *
+         * @param buffer String to read content into. Previous contents are discarded.
+         * @param nbytes Number of bytes to read, defaulting to the index of the last byte of the file.
+         * @param offset Byte offset to begin reading content from (default=0).
+         * @param whence Offset base for movement reference along the file, can be one of
+         *               SEEK_SET, SEEK_CUR or SEEK_END (default=SEEK_CUR).
+         *
+         * @return {size_t} Number of bytes read into the buffer.
+         */
+        size_t      read(std::string& buffer, size_t nbytes = bytes_till_end, off64_t offset = 0, int whence = SEEK_CUR);
+        /**
+         * @brief Reads at most nbytes bytes into a caller-supplied memory region.
+         *        Unlike the string overloads, reaching the end of file is not an error,
+         *        and is indicated by a return value of 0.
+         *
+         * @param buffer Pointer to the memory region to read content into.
+         * @param nbytes Size of the memory region, in bytes.
+         * @param offset Byte offset to begin reading content from (default=0).
+         * @param whence Offset base for movement reference along the file, can be one of
+         *               SEEK_SET, SEEK_CUR or SEEK_END (default=SEEK_CUR).
+         *
+         * @return {size_t} Number of bytes read into the buffer.
+         */
+        size_t      read(char* buffer, size_t nbytes, off64_t offset = 0, int whence = SEEK_CUR);
+        /**
+         * @brief Streams content from the file to a consumer in fixed-size chunks, read through
+         *        a single reused buffer. Memory use is bounded by the chunk size regardless of
+         *        the amount of content, and each chunk is handed over as soon as it is read.
+         *        Unlike {read}, streaming continues over short reads until the end of file
+         *        (for pipes, until all writers have closed their ends).
+         *
+         * @param consumer Callback receiving each chunk of content, in order.
+         * @param chunk_size Size of the buffer used for reading chunks, in bytes.
+         * @param nbytes Number of bytes to stream, defaulting to the index of the last byte of the file.
+         * @param offset Byte offset to begin streaming content from (default=0).
+         * @param whence Offset base for movement reference along the file, can be one of
+         *               SEEK_SET, SEEK_CUR or SEEK_END (default=SEEK_CUR).
+         *
+         * @return {size_t} Total number of bytes streamed.
+         */
+        size_t      stream(
+            const std::function<void(std::string_view)>& consumer, size_t chunk_size,
+            size_t nbytes = bytes_till_end, off64_t offset = 0, int whence = SEEK_CUR
+        );
+
+        /**
+         * @brief Transfers content from the file to another file within the kernel, without
+         *        copying it through user space. Regular files are transferred via `sendfile`,
+         *        and pipes via `splice`. If the kernel rejects the pair of files, content is
+         *        instead copied through a buffer. Semantics of the arguments follow {read}:
+         *        in particular, transfers from pipes end after the first short transfer.
+         *
+         * @param target File to transfer content to, at its current offset.
+         * @param nbytes Number of bytes to transfer, defaulting to the index of the last byte of the file.
+         * @param offset Byte offset to begin transferring content from (default=0).
+         * @param whence Offset base for movement reference along the file, can be one of
+         *               SEEK_SET, SEEK_CUR or SEEK_END (default=SEEK_CUR).
+         *
+         * @return {size_t} Number of bytes transferred.
+         */
+        size_t      send_to(File& target, size_t nbytes = bytes_till_end, off64_t offset = 0, int whence = SEEK_CUR);
+        /**
+         * @brief Transfers content from an absolute offset of the file to another file within the
+         *        kernel, without using or moving the offset of the file table entry. Only regular
+         *        files support positional transfers.
+         *
+         * @param target File to transfer content to, at its current offset.
+         * @param nbytes Number of bytes to transfer, or bytes_till_end to transfer until the end of file.
+         * @param offset Byte offset from the beginning of the file to begin transferring content from.
+         *
+         * @return {size_t} Number of bytes transferred.
+         */
+        size_t      psend_to(File& target, size_t nbytes, off64_t offset);
+
         /**
          * @brief Writes byte data to the file referenced by the object,
          *        optionally at the specified offset location.
@@ -127,10 +256,179 @@ namespace fsop
          * @return {size_t} Number of bytes actually written to the file.
          */
         size_t      write(std::string_view data, off64_t offset = 0, int whence = SEEK_CUR);
+        /**
+         * @brief Writes all of the given byte data to the file referenced by the object,
+         *        optionally at the specified offset location, retrying partial writes.
+         *
+         * For pipes and sockets, content is written first, and only after a short write or
+         * EAGAIN does the writer wait for the file to become writable via poll (instead of
+         * spinning), accounting the time waited as a stall, which indicates that the consumer
+         * is the bottleneck. Blocking writes which wait within the kernel are not accounted.
+         *
+         * @param data Data to write, can be a std::string or a c-string (any type convertible to std::string_view).
+         * @param offset Byte offset to begin writing content to (default=0).
+         * @param whence Offset base for movement reference along the file, can be one of
+         *               SEEK_SET, SEEK_CUR or SEEK_END (default=SEEK_CUR).
+         * @return {size_t} Number of bytes written to the file, equal to the size of data.
+         */
+        size_t      write_all(std::string_view data, off64_t offset = 0, int whence = SEEK_CUR);
+
+        /**
+         * @brief Reads data from an absolute offset into a caller-supplied string buffer, without
+         *        using or moving the offset of the file table entry. Being free of shared state,
+         *        positional reads may be issued concurrently over the same object.
+         *        Failure conditions follow the corresponding {read} overload.
+         *
+         * @param buffer String to read content into. Previous contents are discarded.
+         * @param nbytes Number of bytes to read, or bytes_till_end to read until the end of file.
+         * @param offset Byte offset from the beginning of the file to begin reading content from.
+         *
+         * @return {size_t} Number of bytes read into the buffer.
+         */
+        size_t      pread(std::string& buffer, size_t nbytes, off64_t offset);
+        /**
+         * @brief Reads at most nbytes bytes from an absolute offset into a caller-supplied
+         *        memory region, without using or moving the offset of the file table entry.
+         *        Reaching the end of file is indicated by a return value of 0.
+         *
+         * @param buffer Pointer to the memory region to read content into.
+         * @param nbytes Size of the memory region, in bytes.
+         * @param offset Byte offset from the beginning of the file to begin reading content from.
+         *
+         * @return {size_t} Number of bytes read into the buffer.
+         */
+        size_t      pread(char* buffer, size_t nbytes, off64_t offset);
+        /**
+         * @brief Writes byte data at an absolute offset of the file referenced by the object,
+         *        without using or moving the offset of the file table entry.
+         *
+         * @param data Data to write, can be a std::string or a c-string (any type convertible to std::string_view).
+         * @param offset Byte offset from the beginning of the file to begin writing content to.
+         * @return {size_t} Number of bytes actually written to the file.
+         */
+        size_t      pwrite(std::string_view data, off64_t offset);
+        /**
+         * @brief Writes all of the given byte data at an absolute offset of the file referenced
+         *        by the object, retrying partial writes, without moving the file offset.
+         *
+         * @param data Data to write, can be a std::string or a c-string (any type convertible to std::string_view).
+         * @param offset Byte offset from the beginning of the file to begin writing content to.
+         * @return {size_t} Number of bytes written to the file, equal to the size of data.
+         */
+        size_t      pwrite_all(std::string_view data, off64_t offset);
+
+        /**
+         * @brief Sets the level of durability to maintain for content written via the object.
+         *
+         * With periodic durability, written bytes and the time since the last sync are checked
+         * as writes are issued and batches are committed, and content is synced (via fdatasync)
+         * once either exceeds its threshold; remaining content is synced by {settle}, or when
+         * the file is closed. With batch durability, content is synced when a batch is committed.
+         * In both cases, syncs are shared: writers committing while a sync is in progress wait
+         * for it (or the next one) instead of issuing their own, and commits with no content
+         * written since the last sync return immediately. Copies of the object made after
+         * the call share the level of durability and sync progress.
+         *
+         * @param level Level of durability to maintain.
+         * @param sync_bytes Number of written bytes after which to sync (periodic, 0 to disable).
+         * @param sync_interval Time after the last sync after which to sync (periodic, 0 to disable).
+         */
+        void        set_durability(
+            Durability level, size_t sync_bytes = 0,
+            std::chrono::milliseconds sync_interval = std::chrono::milliseconds{ 0 }
+        );
+        /** Returns the level of durability maintained for written content. */
+        Durability  durability() const noexcept;
+        /**
+         * @brief Marks the end of a batch of writes, making content written so far durable
+         *        as required by the level of durability (none: no effect, periodic: synced
+         *        if a threshold is exceeded, batch: synced). Concurrent commits share a single sync.
+         */
+        void        commit();
+        /**
+         * @brief Marks the end of all writes, syncing content written since the last sync
+         *        regardless of thresholds (none: no effect, otherwise: synced).
+         */
+        void        settle();
+        /** Flushes written content (and metadata required to retrieve it) to the storage device, via fdatasync. */
+        void        sync_data();
+        /** Flushes written content and all metadata to the storage device, via fsync. */
+        void        sync();
+
+        /**
+         * @brief Allocates disk space for a byte range of the file referenced by the object,
+         *        via fallocate, so that later writes to the range do not fail for lack of
+         *        space and are laid out contiguously where possible.
+         *
+         * @param offset Byte offset from the beginning of the file to begin allocation from.
+         * @param nbytes Number of bytes to allocate.
+         * @param mode Mode of allocation, as a combination of FALLOC_FL_* flags (default=0,
+         *             which also extends the file size to cover the range).
+         */
+        void        allocate(off64_t offset, size_t nbytes, int mode = 0);
+
+        /**
+         * @brief Advises the kernel of the expected access pattern over a byte range of
+         *        the file referenced by the object, via posix_fadvise.
+         *
+         * @param offset Byte offset from the beginning of the file the advice applies from.
+         * @param nbytes Number of bytes the advice applies to (0 for till the end of the file).
+         * @param advice One of the POSIX_FADV_* constants.
+         */
+        void        advise(off64_t offset, size_t nbytes, int advice);
+        /**
+         * @brief Initiates reading a byte range of the file referenced by the object into
+         *        the page cache, via readahead, so that subsequent reads do not block on I/O.
+         *
+         * @param offset Byte offset from the beginning of the file to begin reading from.
+         * @param nbytes Number of bytes to read ahead.
+         */
+        void        readahead(off64_t offset, size_t nbytes);
+
+        /** Returns the counters accumulated by write_all and pwrite_all. */
+        const WriteStats& write_stats() const noexcept { return _write_stats; }
+        /** Resets the counters accumulated by write_all and pwrite_all. */
+        void reset_write_stats() noexcept { _write_stats = WriteStats{}; }
+
+        /**
+         * @brief Reads data from an absolute offset into multiple memory regions in a single call
+         *        (scatter input), without using or moving the offset of the file table entry.
+         *        Regions are filled in order, and reaching the end of file is indicated by a
+         *        return value of 0.
+         *
+         * @param vectors Array of memory regions to read content into.
+         * @param count Number of regions in the array (at most IOV_MAX).
+         * @param offset Byte offset from the beginning of the file to begin reading content from.
+         *
+         * @return {size_t} Total number of bytes read across all regions.
+         */
+        size_t      preadv(const struct iovec* vectors, int count, off64_t offset);
+        /**
+         * @brief Writes data from multiple memory regions at an absolute offset in a single call
+         *        (gather output), without using or moving the offset of the file table entry.
+         *
+         * @param vectors Array of memory regions to write content from.
+         * @param count Number of regions in the array (at most IOV_MAX).
+         * @param offset Byte offset from the beginning of the file to begin writing content to.
+         *
+         * @return {size_t} Total number of bytes actually written to the file.
+         */
+        size_t      pwritev(const struct iovec* vectors, int count, off64_t offset);
+        /**
+         * @brief Writes data from multiple memory regions at the current offset in a single call
+         *        (gather output). Usable with pipes and other non-seekable files.
+         *
+         * @param vectors Array of memory regions to write content from.
+         * @param count Number of regions in the array (at most IOV_MAX).
+         *
+         * @return {size_t} Total number of bytes actually written to the file.
+         */
+        size_t      writev(const struct iovec* vectors, int count);
 
         /**
          * @brief Closes the file referenced by the internal descriptor,
          * thereby moving it to an invalid state for future read and write operations.
+         * Content pending under periodic durability is synced first, ignoring failures.
          *
          */
         void close() noexcept;
@@ -151,6 +449,10 @@ namespace fsop
         /**
          * @brief Opens a file for performing I/O.
          *
+         * The file is opened via openat with O_CLOEXEC, and O_NOATIME for read-only opens where
+         * permitted, then described by a single fstat on the descriptor, which is cached for stat().
+         * O_PATH may be passed to obtain a descriptor for inspecting the file without opening its content.
+         *
          * @param path Path to the file to open.
          * @param open_options Options to specify how to open the file.
          * @return {File} The reference to the file descriptor, wrapped in an auto-closeable File object.
@@ -164,23 +466,117 @@ namespace fsop
          * first-out manner, from a writer to a reader. This is useful for communication
          * between processes.
          *
+         * @param capacity Capacity to request for the pipe's buffer, in bytes (default=0, for the system default).
          * @return {std::pair<File, File>} Pair of File instances corresponding to the reader and writer respectively.
          */
-        static std::pair<File, File> create_unnamed_pipe();
+        static std::pair<File, File> create_unnamed_pipe(size_t capacity = 0);
+
+        /**
+         * @brief Returns the capacity of the buffer of the pipe referenced by the object.
+         *
+         * @return {size_t} Capacity of the pipe, in bytes.
+         */
+        size_t pipe_capacity();
+        /**
+         * @brief Changes the capacity of the buffer of the pipe referenced by the object.
+         *        Larger capacities allow producers to run further ahead of consumers,
+         *        reducing context switches between them.
+         *
+         * @param capacity Capacity to request, in bytes. The kernel rounds it up to a power
+         *                 of 2 pages, and unprivileged processes are limited by
+         *                 /proc/sys/fs/pipe-max-size.
+         * @return {size_t} Capacity of the pipe actually set, in bytes.
+         *
+         * @throws {std::system_error} reason for failure of operation (EINVAL for capacities above INT_MAX).
+         */
+        size_t set_pipe_capacity(size_t capacity);
+
+        /** Returns the internal descriptor, for use with system calls not abstracted by the object. */
+        int descriptor() const noexcept { return _descriptor; }
 
         /** Implicit casting operator: determines truthness based on the descriptor. */
         operator bool() { return _descriptor != invalid_descriptor; }
     private:
+        /**
+         * @brief Moves the offset of the file table entry referenced by the descriptor.
+         *
+         * @param offset Byte offset to move to.
+         * @param whence Offset base for movement reference along the file.
+         * @param caller Name of the operation requesting the movement, for error descriptions.
+         * @return {off64_t} The resulting offset, relative to the beginning of the file.
+         */
+        off64_t seek(off64_t offset, int whence, std::string_view caller);
+        /**
+         * @brief Reads content till the end of file into a string buffer.
+         *
+         * For regular files, the read is sized from the file size as per the inode, so that
+         * content is typically read in a single call. Otherwise, reads begin with the preferred
+         * I/O block size and grow geometrically while the file keeps returning full reads.
+         *
+         * @param buffer String to read content into. Previous contents are discarded.
+         * @param position Offset to begin reading from, or -1 if unknown (for non-positional reads).
+         * @param positional If true, reads from position without moving the file offset.
+         * @return {size_t} Number of bytes read into the buffer.
+         */
+        size_t  read_till_end(std::string& buffer, off64_t position, bool positional);
+        /**
+         * @brief Transfers content to another file within the kernel, copying through
+         *        a buffer when the kernel does not support the pair of files.
+         *
+         * @param target File to transfer content to.
+         * @param nbytes Number of bytes to transfer, or bytes_till_end.
+         * @param position Pointer to the offset to transfer from (updated), or nullptr to use the file offset.
+         * @param caller Name of the operation requesting the transfer, for error descriptions.
+         * @return {size_t} Number of bytes transferred.
+         */
+        size_t  transfer(File& target, size_t nbytes, off64_t* position, std::string_view caller);
+        /**
+         * @brief Writes all of the given data, retrying partial writes and waiting
+         *        for the file to become writable when it would block.
+         *
+         * @param data Data to write.
+         * @param position Pointer to the offset to write at, or nullptr to use the file offset.
+         * @param caller Name of the operation requesting the write, for error descriptions.
+         * @return {size_t} Number of bytes written.
+         */
+        size_t  write_fully(std::string_view data, const off64_t* position, std::string_view caller);
+        /**
+         * @brief Waits until the file is writable, accounting the wait as a stall.
+         *
+         * @param caller Name of the operation requesting the wait, for error descriptions.
+         */
+        void    wait_writable(std::string_view caller);
+        /**
+         * @brief Accounts written content for durability, syncing when the level of durability requires.
+         *
+         * @param nbytes Number of bytes written.
+         */
+        void    account_written(size_t nbytes);
+
+        /** State shared by writers for syncing content (group commit). */
+        struct SyncState;
+
+        /** Smallest chunk size used when reading till the end of a file. */
+        static constexpr size_t min_read_chunk = 4096;
+        /** Largest chunk size used for a single read call when reading till the end of a file. */
+        static constexpr size_t max_read_chunk = 1ULL << 30;
+
         /** Internal descriptor maintained by the object. */
         int _descriptor = -1;
         /** Cached file information (inode data). */
         struct stat64 _info;
         /** Indicates whether the file data was cached */
         bool _info_set = false;
+        /** Counters accumulated by full writes. */
+        WriteStats _write_stats;
+        /** Durability settings and sync progress, if a level of durability was set (shared by copies). */
+        std::shared_ptr<SyncState> _sync;
     };
 
     inline constexpr int File::invalid_descriptor;
     inline constexpr size_t File::bytes_till_end;
+    inline constexpr size_t File::min_read_chunk;
+    inline constexpr size_t File::max_read_chunk;
 }
 
 #endif // FSOP_FILE_HPP_INCLUDED
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file file_cache.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines a structure for reusing open files across repeated operations.
+ * @version 1.0
+ * @date 2022-06-22
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_FILE_CACHE_HPP_INCLUDED
+#define FSOP_FILE_CACHE_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <map>         // std::map
+#include <list>        // std::list
+#include <mutex>       // std::mutex
+#include <memory>      // std::shared_ptr
+#include <string>      // std::string
+#include <utility>     // std::pair
+#include <string_view> // std::string_view
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Counters describing the effectiveness of a file cache.
+     */
+    struct FileCacheStats
+    {
+        /** Number of requests served by an already open file. */
+        size_t hits          = 0;
+        /** Number of requests which opened the file. */
+        size_t misses        = 0;
+        /** Number of files closed to make room for others. */
+        size_t evictions     = 0;
+        /** Number of cached files dropped as their path now refers to a different inode. */
+        size_t invalidations = 0;
+        /** Number of requests opened without the cache, as their options act on every open. */
+        size_t bypasses      = 0;
+    };
+
+    /**
+     * @brief Defines a bounded, thread-safe cache of open files, keyed by path and open options,
+     *  which evicts the least recently used file when full.
+     *
+     * Cached files are shared: they keep their file offset across requests, hence positional
+     * I/O (or an explicit seek) should be used over them. Before reuse, the path is checked
+     * to still refer to the inode of the cached file, so that replaced files are reopened.
+     * Evicted files stay open for as long as they are referred to by a previous request.
+     * Opens which truncate or create files (O_TRUNC, O_CREAT, O_EXCL) are never served from
+     * the cache, as their effects apply on every open; O_APPEND is kept by cached files.
+     */
+    struct FileCache
+    {
+        /** Default for the largest number of files kept open. */
+        static constexpr size_t default_capacity = 64;
+
+        /**
+         * @brief Construct a new FileCache object.
+         *
+         * @param capacity Largest number of files kept open, limited to half the
+         *  soft limit for open descriptors of the process (RLIMIT_NOFILE).
+         */
+        explicit FileCache(size_t capacity = default_capacity);
+        FileCache(const FileCache&) = delete;
+        FileCache& operator=(const FileCache&) = delete;
+
+        /**
+         * @brief Returns an open file for a path, opening it only if not already cached.
+         *  Opens with O_TRUNC, O_CREAT or O_EXCL always open the file, without caching it.
+         *
+         * @param path Path to the file to open.
+         * @param open_options Options to specify how to open the file.
+         * @return {std::shared_ptr<File>} The open file.
+         *
+         * @throws {std::system_error} reason for failure of opening the file.
+         */
+        std::shared_ptr<File> open(std::string_view path, int open_options = O_RDONLY);
+
+        /**
+         * @brief Drops all cached files for a path, regardless of open options.
+         *
+         * @param path Path to drop files for.
+         */
+        void invalidate(std::string_view path);
+        /**
+         * @brief Drops all cached files.
+         */
+        void clear();
+
+        /** Returns the number of files currently cached. */
+        size_t size() const;
+        /** Returns the largest number of files kept open. */
+        size_t capacity() const noexcept { return _capacity; }
+        /** Returns the counters of the cache. */
+        FileCacheStats stats() const;
+
+    private:
+        /** Key identifying cached files: the path and open options. */
+        using Key = std::pair<std::string, int>;
+        /** Cached files, most recently used first. */
+        using Entries = std::list<std::pair<Key, std::shared_ptr<File>>>;
+
+        /**
+         * @brief Opens a file, evicting cached files while the process is out of descriptors.
+         *  Must be called with the lock held.
+         */
+        File open_evicting(std::string_view path, int open_options);
+
+        size_t _capacity;
+        mutable std::mutex _mutex;
+        Entries _entries;
+        std::map<Key, Entries::iterator> _index;
+        FileCacheStats _stats;
+    };
+}
+
+#endif // FSOP_FILE_CACHE_HPP_INCLUDED
@@ -0,0 +1,51 @@
+/**
+ * @file ingest.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines functions for ingesting content from files in chunks,
+ *        overlapping reads of a chunk with processing of the previous one.
+ * @version 1.0
+ * @date 2022-06-14
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_INGEST_HPP_INCLUDED
+#define FSOP_INGEST_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <functional>  // std::function
+#include <string_view> // std::string_view
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /** Default size of each buffer used for double-buffered ingestion, in bytes. */
+    inline constexpr size_t default_ingest_chunk = 1ULL << 20;
+
+    /**
+     * @brief Reads content from a file until EOF through two alternating buffers,
+     *  handing each filled buffer to a consumer while the other is refilled
+     *  by a background thread. Memory usage stays bounded by two chunks,
+     *  irrespective of the amount of content ingested.
+     *
+     * Every chunk except the last is filled completely before being handed over,
+     * so that consumers issue few, large system calls even for sources which
+     * deliver content in small pieces (such as pipes and terminals). If the consumer
+     * throws, the background thread is woken up even when blocked waiting for input,
+     * and the exception is propagated without waiting for the source to reach EOF.
+     *
+     * @param source File to read content from, from its current offset.
+     * @param consumer Callback receiving each chunk, in order, on the calling thread.
+     *                 The view is valid only for the duration of the call.
+     * @param chunk_size Size of each buffer, in bytes.
+     * @return {size_t} Total number of bytes ingested.
+     */
+    size_t ingest(
+        File& source, const std::function<void(std::string_view)>& consumer,
+        size_t chunk_size = default_ingest_chunk
+    );
+}
+
+#endif // FSOP_INGEST_HPP_INCLUDED
@@ -12,6 +12,7 @@
 #ifndef FSOP_INSPECT_HPP_INCLUDED
 #define FSOP_INSPECT_HPP_INCLUDED
 
+#include <vector>       // std::vector
 #include <variant>      // std::variant
 #include <iomanip>      // std::put_time
 #include <iostream>     // std::ostream, std::cout
@@ -21,33 +22,56 @@
 #include <cerrno>       // errno, errno macros
 #include <cstring>      // std::strerror
 
-#include <pwd.h>           // getpwuid
+#include <pwd.h>           // getpwuid_r
 //#include <group.h>         // getgrgid
-#include <sys/stat.h>      // stat, struct stat
+#include <sys/stat.h>      // stat, struct stat, statx, STATX_* constants
 #include <sys/types.h>     // 
 // #include <sys/sysmacros.h> // major, minor
 
+#include "fsop/extents.hpp" // fsop::Extent
+
 namespace fsop
 {
     /**
      * @brief A variant over stat structures to hold inode
-     *  information depending on the size requirement.
+     *  information depending on the size requirement, or the
+     *  extended information returned by statx.
      *
      */
-    using stat_info = std::variant<struct stat, struct stat64>;
+    using stat_info = std::variant<struct stat, struct stat64, struct statx>;
+
+    /** Fields requested by default when inspecting files: the basic stat fields and the birth time. */
+    constexpr unsigned int default_stat_fields = STATX_BASIC_STATS | STATX_BTIME;
 
     /**
-     * @brief Inspect the inode of a file, via the stat system call.
+     * @brief Inspect the inode of a file, via the statx system call.
      *
      * This function summarizes available data in the inode, as returned by the
-     * stat system call and returns the data as a stat object.
+     * statx system call and returns the data as a statx object. Only the requested
+     * fields are guaranteed to be retrieved, which spares network and FUSE filesystems
+     * from revalidating the remaining attributes. On kernels without statx, the stat
+     * system call is used instead, which retrieves all fields.
      *
      * @param path Path to the file to inspect.
-     * @param follow_symlinks If true, uses stat instead of lstat to resolve symbolic links.
+     * @param follow_symlinks If true, resolves symbolic links, as stat does instead of lstat.
+     * @param fields Mask of STATX_* fields to retrieve (default=default_stat_fields).
+     * @param dont_sync If true, passes AT_STATX_DONT_SYNC, so that attributes cached
+     *                  locally are returned as is, possibly stale, without a round trip.
      * @return {stat_info} Information related to the file,
      *                     in a structure large enough to hold it.
      */
-    stat_info inspect_file(std::string_view path, bool follow_symlinks = false);
+    stat_info inspect_file(
+        std::string_view path, bool follow_symlinks = false,
+        unsigned int fields = default_stat_fields, bool dont_sync = false
+    );
+
+    /**
+     * @brief Returns the type and mode bits of a file from its inspected information.
+     *
+     * @param info The structure object containing information about the file.
+     * @return {mode_t} The type and mode bits of the file.
+     */
+    mode_t file_mode(const stat_info& info);
 
     /**
      * @brief Prints information received by a call to {inspect_file}
@@ -56,9 +80,42 @@ namespace fsop
      *
      * @param os The output stream to write content to.
      * @param info The structure object containing information to display.
+     * @param fields Mask of STATX_* fields to display (default=default_stat_fields). Requested
+     *               fields not reported by the filesystem are shown as unavailable.
+     * @return {std::ostream&} Reference to the output stream for cascading operations.
+     */
+    std::ostream& print_stat_info(std::ostream& os, const stat_info& info, unsigned int fields = default_stat_fields);
+
+    /**
+     * @brief Retrieves the capacity of the buffer of a named pipe.
+     *
+     * The pipe is opened for reading in non-blocking mode, so that the call
+     * does not wait for a writer to appear.
+     *
+     * @param path Path to the named pipe to inspect.
+     * @return {size_t} Capacity of the pipe, in bytes.
+     */
+    size_t inspect_pipe_capacity(std::string_view path);
+
+    /**
+     * @brief Prints the capacity of a pipe to a given output stream,
+     *  in the same layout as {print_stat_info}.
+     *
+     * @param os The output stream to write content to.
+     * @param capacity Capacity of the pipe, in bytes.
+     * @return {std::ostream&} Reference to the output stream for cascading operations.
+     */
+    std::ostream& print_pipe_info(std::ostream& os, size_t capacity);
+
+    /**
+     * @brief Prints a breakdown of data and holes of a regular file to a given
+     *  output stream, in the same layout as {print_stat_info}.
+     *
+     * @param os The output stream to write content to.
+     * @param extents Extents of the file, as returned by {map_extents}.
      * @return {std::ostream&} Reference to the output stream for cascading operations.
      */
-    std::ostream& print_stat_info(std::ostream& os, const stat_info& info);
+    std::ostream& print_extent_info(std::ostream& os, const std::vector<Extent>& extents);
 }
 
 #endif // FSOP_INSPECT_HPP_INCLUDED
\ No newline at end of file
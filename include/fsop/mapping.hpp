@@ -0,0 +1,112 @@
+/**
+ * @file mapping.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines a structure for abstracting read access to memory-mapped files.
+ * @version 1.0
+ * @date 2022-06-10
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_MAPPING_HPP_INCLUDED
+#define FSOP_MAPPING_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <string_view> // std::string_view
+
+#include <sys/types.h> // off64_t
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Defines a structure for read access to a regular file via a memory mapping.
+     *
+     * MappedFile objects map the complete content of a regular file into the address space
+     * of the process, and serve reads as views over the mapped region. Once pages are resident
+     * in the page cache, reads require no system calls. Mappings follow the RAII idiom and are
+     * unmapped when the corresponding object runs out of scope. Mappings are move-only.
+     */
+    struct MappedFile
+    {
+        /**
+         * @brief Construct a new MappedFile object, mapping the content of a regular file.
+         *
+         * The mapping maintains its own offset, initialized from the offset of the given file,
+         * which is moved by reads in the same manner as with {File::read}.
+         *
+         * @param file Regular file (opened for reading) to map into memory.
+         *
+         * @throws {std::system_error} reason for failure of operation.
+         */
+        explicit MappedFile(File& file);
+        /** Disallow creation via copy constructor. */
+        MappedFile(const MappedFile&) = delete;
+        /**
+         * @brief Construct a new MappedFile object
+         *
+         * @param tmp_mapping Temporary mapping object. Ownership of the mapped region
+         *                    is transferred to the current object.
+         */
+        MappedFile(MappedFile&& tmp_mapping) noexcept
+        : _data(tmp_mapping._data), _size(tmp_mapping._size), _offset(tmp_mapping._offset)
+        {
+            tmp_mapping._data = nullptr;
+            tmp_mapping._size = 0;
+        }
+        /**
+         * @brief Destroy the MappedFile object, after unmapping the mapped region.
+         */
+        ~MappedFile()
+        {
+            this->unmap();
+        }
+
+        /** Disallow copy assignment of objects. */
+        MappedFile& operator=(const MappedFile&) = delete;
+        /**
+         * @brief Move assignment: Moves the mapped region, effectively transferring ownership.
+         *
+         * @param tmp_mapping Temporary mapping object. Ownership of the mapped region
+         *                    is transferred to the current object.
+         * @return {MappedFile&} Reference to the current object, for chaining operations.
+         */
+        MappedFile& operator=(MappedFile&& tmp_mapping) noexcept;
+
+        /**
+         * @brief Returns a view over bytes of the mapped file, moving the mapping's offset past them.
+         *        Semantics of the arguments and failure conditions follow {File::read}.
+         *
+         * The returned view remains valid until the mapping is destroyed, unmapped or moved.
+         *
+         * @param nbytes Number of bytes to view, defaulting to the index of the last byte of the file.
+         * @param offset Byte offset to begin viewing content from (default=0).
+         * @param whence Offset base for movement reference along the file, can be one of
+         *               SEEK_SET, SEEK_CUR or SEEK_END (default=SEEK_CUR).
+         *
+         * @return {std::string_view} A view over the mapped content.
+         */
+        std::string_view read(size_t nbytes = File::bytes_till_end, off64_t offset = 0, int whence = SEEK_CUR);
+
+        /**
+         * @brief Unmaps the mapped region, thereby moving the object
+         * to an invalid state for future read operations.
+         */
+        void unmap() noexcept;
+
+        /** Returns the size of the mapped region, in bytes. */
+        size_t size() const noexcept { return _size; }
+
+    private:
+        /** Start of the mapped region. */
+        const char* _data = nullptr;
+        /** Size of the mapped region. */
+        size_t _size = 0;
+        /** Offset maintained for reads over the mapping. */
+        off64_t _offset = 0;
+    };
+}
+
+#endif // FSOP_MAPPING_HPP_INCLUDED
@@ -0,0 +1,69 @@
+/**
+ * @file parallel.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines functions for performing I/O over byte ranges of files from multiple threads.
+ * @version 1.0
+ * @date 2022-06-17
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_PARALLEL_HPP_INCLUDED
+#define FSOP_PARALLEL_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+
+#include <functional>  // std::function
+#include <string_view> // std::string_view
+
+#include <sys/types.h> // off64_t
+
+#include "fsop/file.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Reads a byte range of a file in chunks via positional reads issued from a pool
+     *  of worker threads sharing the descriptor, and hands the chunks to a consumer in order.
+     *
+     * Workers run ahead of the consumer by at most two chunks each, so that memory usage
+     * stays bounded by (2 x workers) chunks irrespective of the size of the range.
+     *
+     * @param file File to read content from (supporting positional reads).
+     * @param consumer Callback receiving each chunk, in order, on the calling thread.
+     *                 The view is valid only for the duration of the call.
+     * @param offset Byte offset from the beginning of the file to begin reading from.
+     * @param nbytes Number of bytes to read (reads stop early at the end of the file).
+     * @param chunk_size Number of bytes read per positional read.
+     * @param workers Number of worker threads to read with.
+     * @return {size_t} Total number of bytes handed to the consumer.
+     */
+    size_t read_parallel(
+        File& file, const std::function<void(std::string_view)>& consumer,
+        off64_t offset, size_t nbytes, size_t chunk_size, unsigned workers
+    );
+
+    /**
+     * @brief Copies a byte range of a file to another via positional reads and writes issued
+     *  from a pool of worker threads sharing both descriptors, each worker copying a chunk at a time.
+     *
+     * Content is synced only as required by the level of durability set on the target; use
+     * File::settle once the call returns to make the copy durable as a whole.
+     *
+     * @param source File to read content from (supporting positional reads).
+     * @param source_offset Byte offset of the range in the source.
+     * @param target File to write content to (supporting positional writes).
+     * @param target_offset Byte offset to write the range at in the target.
+     * @param nbytes Number of bytes to copy (copies stop early at the end of the source).
+     * @param chunk_size Number of bytes copied per positional read/write.
+     * @param workers Number of worker threads to copy with.
+     * @param preallocate Whether to allocate the target range via fallocate before writing.
+     * @return {size_t} Total number of bytes written.
+     */
+    size_t write_parallel(
+        File& source, off64_t source_offset, File& target, off64_t target_offset,
+        size_t nbytes, size_t chunk_size, unsigned workers, bool preallocate = false
+    );
+}
+
+#endif // FSOP_PARALLEL_HPP_INCLUDED
@@ -0,0 +1,125 @@
+/**
+ * @file uring.hpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Defines a structure for abstracting asynchronous I/O via io_uring instances.
+ * @version 1.0
+ * @date 2022-06-14
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef FSOP_URING_HPP_INCLUDED
+#define FSOP_URING_HPP_INCLUDED
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+
+#include <memory>      // std::unique_ptr
+#include <vector>      // std::vector
+#include <functional>  // std::function
+#include <string_view> // std::string_view
+
+#include <sys/types.h> // off64_t
+
+#include "fsop/file.hpp"
+#include "fsop/batch.hpp"
+
+namespace fsop
+{
+    /**
+     * @brief Defines a structure for submitting asynchronous I/O requests via an io_uring instance.
+     *
+     * Requests are prepared in a submission queue shared with the kernel, submitted together
+     * by a single system call, and their results are reaped from a completion queue in the order
+     * the kernel completes them. Each request carries a tag which is returned with its result.
+     * Rings follow the RAII idiom and are torn down when the corresponding object runs out of scope.
+     */
+    struct IORing
+    {
+        /**
+         * @brief Construct a new IORing object, setting up an io_uring instance.
+         *
+         * @param queue_depth Number of submission queue entries (rounded up to a power of 2 by the kernel).
+         *
+         * @throws {std::system_error} reason for failure of operation (ENOSYS if io_uring is unsupported).
+         */
+        explicit IORing(unsigned queue_depth);
+        /** Disallow creation via copy constructor. */
+        IORing(const IORing&) = delete;
+        /**
+         * @brief Destroy the IORing object, after unmapping the rings and closing the instance.
+         */
+        ~IORing();
+
+        /** Disallow copy assignment of objects. */
+        IORing& operator=(const IORing&) = delete;
+
+        /**
+         * @brief Prepares a positional read request in the submission queue.
+         *
+         * @param descriptor File descriptor to read content from.
+         * @param buffer Pointer to the memory region to read content into.
+         * @param nbytes Size of the memory region, in bytes.
+         * @param offset Byte offset from the beginning of the file to begin reading content from.
+         * @param tag Value identifying the request in its completion.
+         * @return {bool} false if the submission queue is full, true otherwise.
+         */
+        bool prepare_read(int descriptor, char* buffer, unsigned nbytes, off64_t offset, std::uint64_t tag) noexcept;
+
+        /**
+         * @brief Submits all prepared requests to the kernel, optionally waiting for completions.
+         *
+         * @param min_complete Number of completions to wait for (default=0).
+         * @return {unsigned} Number of requests submitted.
+         *
+         * @throws {std::system_error} reason for failure of operation.
+         */
+        unsigned submit(unsigned min_complete = 0);
+
+        /**
+         * @brief Retrieves the next available completion from the completion queue.
+         *
+         * @param tag Set to the tag of the completed request.
+         * @param result Set to the result of the completed request (bytes transferred, or -errno).
+         * @return {bool} false if no completion is available, true otherwise.
+         */
+        bool next_completion(std::uint64_t& tag, int& result) noexcept;
+
+        /** Returns the number of submission queue entries. */
+        unsigned queue_depth() const noexcept;
+
+    private:
+        /** Mapped submission and completion rings (defined in the source file). */
+        struct Rings;
+
+        /** Descriptor of the io_uring instance. */
+        int _descriptor = File::invalid_descriptor;
+        /** Mapped rings of the instance. */
+        std::unique_ptr<Rings> _rings;
+    };
+
+    /**
+     * @brief Reads a list of batches from a file via io_uring, keeping up to queue_depth reads in flight.
+     *
+     * All batches are submitted as soon as slots in the queue free up, and completions are reaped
+     * out of order. Content is however delivered in batch order: each batch is handed over once it
+     * and all preceding batches are complete, after which its buffer is released. At most
+     * queue_depth batches are in flight or awaiting delivery at any time, bounding memory usage.
+     *
+     * @param file File to read content from (must support positional reads).
+     * @param batches Batches to read. Byte counts must be finite (not File::bytes_till_end).
+     * @param queue_depth Maximum number of reads in flight.
+     * @param on_ready Callback receiving the index of a batch and its content, invoked in batch order.
+     *                 Content is shorter than requested at EOF.
+     * @return {size_t} Number of system calls issued.
+     *
+     * @throws {std::system_error} reason for failure of operation: errors of IORing() if the ring
+     *  cannot be set up, or EOPNOTSUPP if the kernel does not support io_uring reads.
+     */
+    size_t read_batches_async(
+        File& file, const std::vector<Batch>& batches, unsigned queue_depth,
+        const std::function<void(size_t, std::string_view)>& on_ready
+    );
+}
+
+#endif // FSOP_URING_HPP_INCLUDED
@@ -18,6 +18,8 @@ while IFS= read -r -d $'\0'; do
 done < <(find $SRCDIR -type f -name "*.cpp" -print0)
 # C++ flags to use during compilation.
 CXXFLAGS="-std=c++17 -Wall -Wextra -g"
+# Linker flags to use when generating the target (threads for chunked ingestion).
+LDFLAGS="-pthread"
 # Preprocessor flags to use during compilation.
 CPPFLAGS="-MMD -MP -MF <depfile>"
 # C++ compiler to use.
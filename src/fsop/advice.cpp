@@ -0,0 +1,52 @@
+/**
+ * @file advice.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the functions defined in fsop/advice.hpp
+ * @version 1.0
+ * @date 2022-06-19
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/advice.hpp"
+
+#include <fcntl.h>      // POSIX_FADV_* constants
+
+auto fsop::classify_access(const std::vector<Batch>& batches, size_t max_gap) -> AccessPattern
+{
+    for(size_t index = 1; index < batches.size(); ++index)
+    {
+        auto previous_end = batches[index-1].offset + static_cast<off64_t>(batches[index-1].nbytes);
+        auto offset = batches[index].offset;
+        if(offset < previous_end or static_cast<size_t>(offset - previous_end) > max_gap)
+            return AccessPattern::random;
+    }
+    return AccessPattern::sequential;
+}
+
+auto fsop::advise_access(File& file, const std::vector<Batch>& batches) -> AccessPattern
+{
+    auto pattern = classify_access(batches);
+    if(batches.empty()) return pattern;
+
+    if(pattern == AccessPattern::sequential)
+    {
+        const auto& first = batches.front(); const auto& last = batches.back();
+        auto span = last.offset + static_cast<off64_t>(last.nbytes) - first.offset;
+        file.advise(first.offset, span, POSIX_FADV_SEQUENTIAL);
+        if(first.nbytes > 0) file.readahead(first.offset, first.nbytes);
+    }
+    else
+    {
+        file.advise(0, 0, POSIX_FADV_RANDOM);
+        for(const auto& batch : batches)
+            if(batch.nbytes > 0) file.advise(batch.offset, batch.nbytes, POSIX_FADV_WILLNEED);
+    }
+    return pattern;
+}
+
+void fsop::drop_cached(File& file, const std::vector<Batch>& batches)
+{
+    for(const auto& batch : batches)
+        if(batch.nbytes > 0) file.advise(batch.offset, batch.nbytes, POSIX_FADV_DONTNEED);
+}
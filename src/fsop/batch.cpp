@@ -0,0 +1,182 @@
+/**
+ * @file batch.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the functions defined in fsop/batch.hpp
+ * @version 1.0
+ * @date 2022-06-12
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/batch.hpp"
+
+#include <climits>      // IOV_MAX
+
+#include <numeric>      // std::iota
+#include <algorithm>    // std::min, std::max, std::stable_sort
+
+#include <sys/uio.h>    // struct iovec
+
+namespace
+{
+    /**
+     * @brief Advances a list of regions past a given number of processed bytes.
+     *
+     * @param vectors Regions being processed.
+     * @param index Index of the first unprocessed region, updated in place.
+     * @param nbytes Number of bytes processed.
+     * @param on_consume Callback receiving the index of a region and the bytes consumed from it.
+     */
+    template<typename Callback>
+    void advance_vectors(std::vector<struct iovec>& vectors, size_t& index, size_t nbytes, Callback&& on_consume)
+    {
+        while(index < vectors.size() and (nbytes > 0 or vectors[index].iov_len == 0))
+        {
+            auto& vector = vectors[index];
+            size_t consumed = std::min(nbytes, vector.iov_len);
+            on_consume(index, consumed);
+            vector.iov_base = static_cast<char*>(vector.iov_base) + consumed;
+            vector.iov_len -= consumed; nbytes -= consumed;
+            if(vector.iov_len == 0) ++index;
+        }
+    }
+}
+
+size_t fsop::read_batches(
+    File& file, const std::vector<Batch>& batches,
+    std::vector<std::string>& buffers, size_t max_gap
+)
+{
+    static constexpr size_t no_owner = -1ULL;
+
+    buffers.resize(batches.size());
+    std::vector<size_t> order(batches.size()), nbytes_read(batches.size(), 0);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return batches[lhs].offset < batches[rhs].offset;
+    });
+    for(size_t index = 0; index < batches.size(); ++index)
+        buffers[index].resize(batches[index].nbytes);
+
+    // Scratch region for bridged gaps: content is read and discarded.
+    std::string gap_buffer;
+    // Regions of the current run, and the batch owning each region.
+    std::vector<struct iovec> vectors; std::vector<size_t> owners;
+    off64_t run_offset = 0, run_end = 0; size_t ncalls = 0;
+
+    auto read_run = [&]() {
+        // The scratch region is sized for the largest gap of the run before any region
+        // refers to it, as growing it afterwards would leave earlier regions dangling.
+        size_t largest_gap = 0;
+        for(size_t index = 0; index < vectors.size(); ++index)
+            if(owners[index] == no_owner) largest_gap = std::max(largest_gap, vectors[index].iov_len);
+        if(gap_buffer.size() < largest_gap) gap_buffer.resize(largest_gap);
+        for(size_t index = 0; index < vectors.size(); ++index)
+            if(owners[index] == no_owner) vectors[index].iov_base = gap_buffer.data();
+
+        size_t index = 0; off64_t position = run_offset;
+        while(index < vectors.size())
+        {
+            int count = static_cast<int>(std::min<size_t>(vectors.size() - index, IOV_MAX));
+            auto nbytes = file.preadv(&vectors[index], count, position); ++ncalls;
+            if(nbytes == 0) break; // End of file, remaining batches stay short.
+            position += nbytes;
+            advance_vectors(vectors, index, nbytes, [&](size_t vector_index, size_t consumed) {
+                if(owners[vector_index] != no_owner) nbytes_read[owners[vector_index]] += consumed;
+            });
+        }
+        vectors.clear(); owners.clear();
+    };
+
+    for(auto batch_index : order)
+    {
+        const auto& batch = batches[batch_index];
+        if(batch.nbytes == 0) continue;
+
+        bool extends_run = not vectors.empty() and batch.offset >= run_end
+                           and static_cast<size_t>(batch.offset - run_end) <= max_gap;
+        if(not extends_run)
+        {
+            if(not vectors.empty()) read_run();
+            run_offset = run_end = batch.offset;
+        }
+        else if(batch.offset > run_end)
+        {
+            // Gaps are pointed to the scratch region once the run is complete.
+            size_t gap = batch.offset - run_end;
+            vectors.push_back({ nullptr, gap });
+            owners.push_back(no_owner);
+        }
+        vectors.push_back({ buffers[batch_index].data(), batch.nbytes });
+        owners.push_back(batch_index);
+        run_end = batch.offset + batch.nbytes;
+    }
+    if(not vectors.empty()) read_run();
+
+    for(size_t index = 0; index < batches.size(); ++index)
+        buffers[index].resize(nbytes_read[index]);
+    return ncalls;
+}
+
+size_t fsop::write_batches(
+    File& file, const std::vector<off64_t>& offsets,
+    const std::vector<std::string>& data, std::vector<size_t>& nbytes_written
+)
+{
+    nbytes_written.assign(offsets.size(), 0);
+
+    std::vector<struct iovec> vectors; std::vector<size_t> owners;
+    off64_t run_offset = 0, run_end = 0; size_t ncalls = 0;
+
+    auto write_run = [&]() {
+        size_t index = 0; off64_t position = run_offset;
+        while(index < vectors.size())
+        {
+            int count = static_cast<int>(std::min<size_t>(vectors.size() - index, IOV_MAX));
+            auto nbytes = file.pwritev(&vectors[index], count, position); ++ncalls;
+            if(nbytes == 0) break;
+            position += nbytes;
+            advance_vectors(vectors, index, nbytes, [&](size_t vector_index, size_t consumed) {
+                nbytes_written[owners[vector_index]] += consumed;
+            });
+        }
+        vectors.clear(); owners.clear();
+    };
+
+    for(size_t batch_index = 0; batch_index < offsets.size(); ++batch_index)
+    {
+        const auto& content = data[batch_index];
+        if(content.empty()) continue;
+
+        if(vectors.empty() or offsets[batch_index] != run_end)
+        {
+            if(not vectors.empty()) write_run();
+            run_offset = run_end = offsets[batch_index];
+        }
+        vectors.push_back({ const_cast<char*>(content.data()), content.size() });
+        owners.push_back(batch_index);
+        run_end += content.size();
+    }
+    if(not vectors.empty()) write_run();
+
+    return ncalls;
+}
+
+size_t fsop::write_vectored(File& file, const std::vector<std::string_view>& data)
+{
+    std::vector<struct iovec> vectors; vectors.reserve(data.size());
+    for(const auto& content : data)
+        if(not content.empty())
+            vectors.push_back({ const_cast<char*>(content.data()), content.size() });
+
+    size_t index = 0, total = 0;
+    while(index < vectors.size())
+    {
+        int count = static_cast<int>(std::min<size_t>(vectors.size() - index, IOV_MAX));
+        auto nbytes = file.writev(&vectors[index], count);
+        if(nbytes == 0) break;
+        total += nbytes;
+        advance_vectors(vectors, index, nbytes, [](size_t, size_t) {});
+    }
+    return total;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file buffered_file.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the methods defined in fsop/buffered_file.hpp
+ * @version 1.0
+ * @date 2022-06-15
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/buffered_file.hpp"
+
+#include <system_error> // std::system_error
+
+fsop::BufferedFile::BufferedFile(File& file, size_t capacity)
+: _file(file), _capacity(capacity)
+{
+    if(_capacity == 0)
+        throw std::system_error(EINVAL, std::generic_category(), "BufferedFile(): capacity must be positive");
+    _buffer.reserve(_capacity);
+}
+
+fsop::BufferedFile::~BufferedFile()
+{
+    try { flush(); }
+    catch(std::system_error&) {}
+}
+
+size_t fsop::BufferedFile::write(std::string_view data, off64_t offset, int whence)
+{
+    if(whence != SEEK_CUR or offset != 0)
+    {
+        flush();
+        // An empty full write only moves the offset.
+        _file.write_all(std::string_view{}, offset, whence);
+    }
+
+    if(_buffer.size() + data.size() > _capacity)
+        flush();
+    if(data.size() >= _capacity)
+        return _file.write_all(data);
+
+    _buffer.append(data);
+    if(_buffer.size() == _capacity)
+        flush();
+    return data.size();
+}
+
+size_t fsop::BufferedFile::flush()
+{
+    if(_buffer.empty()) return 0;
+
+    // Drop pending content even on failure, so that the destructor does not retry it.
+    std::string pending; pending.reserve(_capacity);
+    pending.swap(_buffer);
+    return _file.write_all(pending);
+}
@@ -9,21 +9,94 @@
  */
 
 #include "fsop/create.hpp"
+#include "fsop/directory.hpp" // fsop::resolve_path
 
 #include <cerrno>       // errno, errno macros
 #include <cstring>      // std::strerror
 
+#include <string>       // std::string
+#include <algorithm>    // std::min
 #include <system_error> // std::system_error
 
-#include <fcntl.h>      // creat (Android)
-#include <unistd.h>     // creat (MinGW), mode_t
+#include <fcntl.h>      // openat, fstatat, mknodat, fchmodat
+#include <unistd.h>     // unlinkat, close, mode_t
 #include <sys/stat.h>   // S_* constant macros, mknod (Android), chmod (Android)
 
-void fsop::create_file(std::string_view path, mode_t permissions, bool overwrite)
+namespace
 {
+    /** Size of the buffer of zeros written per call when zero-filling files, in bytes. */
+    constexpr size_t zero_fill_chunk = 1 << 20;
+
+    /**
+     * @brief Allocates the initial content of a newly created regular file.
+     *
+     * @param fd Descriptor of the file, open for writing.
+     * @param size Size to allocate, in bytes.
+     * @param allocation How the content is allocated.
+     */
+    void allocate_content(int fd, size_t size, fsop::Allocation allocation)
+    {
+        int status = 0;
+        switch(allocation)
+        {
+            case fsop::Allocation::preallocate:
+                status = fallocate64(fd, 0, 0, static_cast<off64_t>(size));
+                break;
+            case fsop::Allocation::sparse:
+                status = ftruncate64(fd, static_cast<off64_t>(size));
+                break;
+            case fsop::Allocation::zero:
+            {
+                std::string zeros(std::min(size, zero_fill_chunk), '\0');
+                for(size_t done = 0; done < size and status != -1; )
+                {
+                    auto nbytes = write(fd, zeros.data(), std::min(size - done, zeros.size()));
+                    if(nbytes == -1) { if(errno != EINTR) status = -1; }
+                    else done += nbytes;
+                }
+                break;
+            }
+        }
+        if(status == -1)
+        {
+            std::string error_desc = "create_file(): failed to allocate content: ";
+            switch(errno)
+            {
+                case EOPNOTSUPP:
+                    error_desc += "filesystem does not support preallocation (use sparse or zero allocation)";
+                    break;
+                case ENOSPC:
+                    error_desc += "insufficient space left on the device";
+                    break;
+                case EFBIG:
+                    error_desc += "size exceeds the maximum file size";
+                    break;
+                case EDQUOT:
+                    error_desc += "user disk block quota exhausted";
+                    break;
+                case EIO:
+                    error_desc += "low-level I/O error";
+                    break;
+                default:
+                    error_desc += "unknown, code " + std::to_string(errno);
+            }
+            throw std::system_error(errno, std::generic_category(), error_desc.c_str());
+        }
+    }
+}
+
+void fsop::create_file(
+    std::string_view path, mode_t permissions, bool overwrite,
+    size_t size, Allocation allocation
+)
+{
+    // Only the leaf component is looked up, relative to a cached handle of the parent directory.
+    auto resolved = resolve_path(path);
+    auto directory = resolved.directory(); auto name = resolved.name.c_str();
+
     // Check if file previously exists
     struct stat inode_data;
-    int status = stat(path.data(), &inode_data);
+    int status = fstatat(directory, name, &inode_data, 0);
     if(status != -1)
     {
         if(not overwrite)
@@ -36,15 +109,22 @@ void fsop::create_file(std::string_view path, mode_t permissions, bool overwrite
             );
         }
         else if((inode_data.st_mode & S_IFMT) != S_IFREG)
-            if(unlink(path.data()) == -1)
+            if(unlinkat(directory, name, 0) == -1)
                 throw std::system_error
                 (
                     errno, std::generic_category(),
                     "create_file(): unable to unlink previously existing file for overwrite"
                 );
     }
-    // Aliter: open(path.data(), O_CREAT | O_WRONLY | O_TRUNC, permissions);
-    int fd = creat(path.data(), permissions);
+    // Equivalent to creat(path.data(), permissions), relative to the parent directory.
+    int fd = openat(directory, name, O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, permissions);
+    if(fd == -1 and refresh_path(resolved, path))
+    {
+        // The parent directory was replaced since it was cached: create the file in the current one,
+        // failing if the file exists there unless overwriting.
+        directory = resolved.directory(); name = resolved.name.c_str();
+        fd = openat(directory, name, O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC | (overwrite ? 0 : O_EXCL), permissions);
+    }
     if(fd == -1 and (not overwrite or errno != EEXIST))
     {
         std::string error_desc = "create_file(): ";
@@ -107,15 +187,32 @@ void fsop::create_file(std::string_view path, mode_t permissions, bool overwrite
             );
         }
     }
+    // Allocate initial content.
+    if(size > 0)
+    {
+        try
+        {
+            allocate_content(fd, size, allocation);
+        }
+        catch(...)
+        {
+            close(fd);
+            throw;
+        }
+    }
     // close the file, since creat also opens the file for writing.
     close(fd);
 }
 
 void fsop::create_pipe(std::string_view path, mode_t permissions, bool overwrite)
 {
+    // Only the leaf component is looked up, relative to a cached handle of the parent directory.
+    auto resolved = resolve_path(path);
+    auto directory = resolved.directory(); auto name = resolved.name.c_str();
+
     // Check if file previously exists
     struct stat inode_data;
-    int status = stat(path.data(), &inode_data);
+    int status = fstatat(directory, name, &inode_data, 0);
     if(status != -1)
     {
         if(not overwrite)
@@ -128,14 +225,20 @@ void fsop::create_pipe(std::string_view path, mode_t permissions, bool overwrite
             );
         }
         else if((inode_data.st_mode & S_IFMT) != S_IFIFO)
-            if(unlink(path.data()) == -1)
+            if(unlinkat(directory, name, 0) == -1)
                 throw std::system_error
                 (
                     errno, std::generic_category(),
                     "create_pipe(): unable to unlink previously existing file for overwrite"
                 );
     }
-    status = mknod(path.data(), S_IFIFO | permissions, 0);
+    status = mknodat(directory, name, S_IFIFO | permissions, 0);
+    if(status == -1 and refresh_path(resolved, path))
+    {
+        // The parent directory was replaced since it was cached: create the pipe in the current one.
+        directory = resolved.directory(); name = resolved.name.c_str();
+        status = mknodat(directory, name, S_IFIFO | permissions, 0);
+    }
     if(status == -1 and (not overwrite or errno != EEXIST))
     {
         std::string error_desc = "create_pipe(): ";
@@ -174,7 +277,7 @@ void fsop::create_pipe(std::string_view path, mode_t permissions, bool overwrite
         throw std::system_error(errno, std::generic_category(), error_desc.c_str());
     }
     // Verify successful pipe creation.
-    status = stat(path.data(), &inode_data);
+    status = fstatat(directory, name, &inode_data, 0);
     if(status == -1)
     {
         throw std::system_error
@@ -186,7 +289,7 @@ void fsop::create_pipe(std::string_view path, mode_t permissions, bool overwrite
     // Fix permissions.
     if((inode_data.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO)) != permissions)
     {
-        status = chmod(path.data(), permissions);
+        status = fchmodat(directory, name, permissions, 0);
         if(status == -1)
         {
             throw std::system_error
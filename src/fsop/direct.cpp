@@ -0,0 +1,214 @@
+/**
+ * @file direct.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the functions defined in fsop/direct.hpp
+ * @version 1.0
+ * @date 2022-06-18
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/direct.hpp"
+
+#include <cerrno>       // errno, errno macros
+#include <cstdlib>      // std::free
+#include <cstring>      // std::memcpy, std::memset
+
+#include <algorithm>    // std::min, std::max
+#include <system_error> // std::system_error
+
+#include <fcntl.h>      // AT_EMPTY_PATH
+#include <unistd.h>     // ftruncate64
+#include <sys/stat.h>   // statx, STATX_DIOALIGN
+
+namespace
+{
+    /**
+     * @brief Rounds a value up to a multiple of an alignment.
+     *
+     * @param value Value to round.
+     * @param alignment Alignment to round to.
+     * @return {size_t} The rounded value.
+     */
+    constexpr size_t align_up(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Reads a block into a buffer, filling bytes past the end of the file with zeros.
+     *
+     * @param file File to read from.
+     * @param buffer Aligned buffer to read into.
+     * @param block_size Size of the block.
+     * @param position Aligned offset of the block.
+     */
+    void read_block(fsop::File& file, char* buffer, size_t block_size, off64_t position)
+    {
+        auto nbytes_read = file.pread(buffer, block_size, position);
+        std::memset(buffer + nbytes_read, 0, block_size - nbytes_read);
+    }
+
+    /**
+     * @brief Validates that a pool's buffers can serve I/O under given alignment requirements.
+     *
+     * @param pool Pool to validate.
+     * @param alignment Alignment requirements of the file.
+     * @param caller Name of the operation requesting validation, for error descriptions.
+     */
+    void check_pool(const fsop::AlignedBufferPool& pool, const fsop::DirectAlignment& alignment, std::string_view caller)
+    {
+        if(pool.alignment() % alignment.memory != 0 or pool.buffer_size() % alignment.offset != 0)
+        {
+            std::string error_desc { caller.data(), caller.size() };
+            error_desc += "(): buffers of the pool do not satisfy the alignment requirements of the file";
+            throw std::system_error(EINVAL, std::generic_category(), error_desc);
+        }
+    }
+}
+
+fsop::DirectAlignment fsop::direct_alignment(File& file)
+{
+    size_t fallback = std::max<size_t>(file.stat().st_blksize, 512);
+
+#ifdef STATX_DIOALIGN
+    struct statx info;
+    if(statx(file.descriptor(), "", AT_EMPTY_PATH, STATX_DIOALIGN, &info) == 0 and
+       (info.stx_mask & STATX_DIOALIGN) and info.stx_dio_offset_align > 0)
+        return { info.stx_dio_mem_align, info.stx_dio_offset_align };
+#endif
+
+    return { fallback, fallback };
+}
+
+fsop::AlignedBufferPool::AlignedBufferPool(size_t buffer_size, size_t alignment, size_t initial_count)
+: _buffer_size(align_up(std::max<size_t>(buffer_size, 1), alignment)), _alignment(alignment)
+{
+    if(alignment == 0 or (alignment & (alignment - 1)) != 0)
+        throw std::system_error(EINVAL, std::generic_category(), "AlignedBufferPool(): alignment must be a power of 2");
+
+    try
+    {
+        for(size_t index = 0; index < initial_count; ++index)
+            _free.push_back(allocate());
+    }
+    catch(...)
+    {
+        for(auto buffer : _all) std::free(buffer);
+        throw;
+    }
+}
+
+fsop::AlignedBufferPool::~AlignedBufferPool()
+{
+    for(auto buffer : _all) std::free(buffer);
+}
+
+char* fsop::AlignedBufferPool::allocate()
+{
+    void* buffer = nullptr;
+    // posix_memalign requires alignments of at least the size of a pointer.
+    auto status = posix_memalign(&buffer, std::max(_alignment, sizeof(void*)), _buffer_size);
+    if(status != 0)
+        throw std::system_error(status, std::generic_category(), "AlignedBufferPool(): failed to allocate buffer");
+    try
+    {
+        _all.push_back(static_cast<char*>(buffer));
+        _free.reserve(_all.size());
+    }
+    catch(...)
+    {
+        if(_all.empty() or _all.back() != buffer) std::free(buffer);
+        throw;
+    }
+    return static_cast<char*>(buffer);
+}
+
+fsop::AlignedBufferPool::Lease fsop::AlignedBufferPool::acquire()
+{
+    std::lock_guard guard { _lock };
+    if(_free.empty()) return Lease{ *this, allocate() };
+    auto buffer = _free.back(); _free.pop_back();
+    return Lease{ *this, buffer };
+}
+
+void fsop::AlignedBufferPool::release(char* data) noexcept
+{
+    std::lock_guard guard { _lock };
+    // Capacity for all buffers is reserved as they are allocated, so this does not throw.
+    _free.push_back(data);
+}
+
+size_t fsop::read_direct(
+    File& file, AlignedBufferPool& pool, const DirectAlignment& alignment,
+    const std::function<void(std::string_view)>& consumer, off64_t offset, size_t nbytes
+)
+{
+    check_pool(pool, alignment, "read_direct");
+
+    const size_t block = alignment.offset, buffer_size = pool.buffer_size();
+    auto lease = pool.acquire();
+
+    // Reads begin at the block containing the offset, and skip the unaligned head.
+    auto position = offset - static_cast<off64_t>(offset % block);
+    size_t skip = offset - position, remaining = nbytes, total = 0;
+
+    while(remaining > 0)
+    {
+        auto length = remaining >= buffer_size ? buffer_size : std::min(buffer_size, align_up(skip + remaining, block));
+        auto nbytes_read = file.pread(lease.data(), length, position);
+        if(nbytes_read <= skip) break;
+
+        // Trim the unaligned tail, beyond the requested range.
+        auto available = std::min(nbytes_read - skip, remaining);
+        consumer(std::string_view{ lease.data() + skip, available });
+        total += available; remaining -= available;
+        position += nbytes_read; skip = 0;
+
+        if(nbytes_read < length) break;
+    }
+    return total;
+}
+
+size_t fsop::write_direct(
+    File& file, AlignedBufferPool& pool, const DirectAlignment& alignment,
+    std::string_view data, off64_t offset
+)
+{
+    check_pool(pool, alignment, "write_direct");
+    if(data.empty()) return 0;
+
+    const size_t block = alignment.offset, buffer_size = pool.buffer_size();
+    file.invalidate_cache();
+    auto original_size = static_cast<off64_t>(file.stat().st_size);
+
+    const off64_t end = offset + static_cast<off64_t>(data.size());
+    const off64_t aligned_begin = offset - static_cast<off64_t>(offset % block);
+    const off64_t aligned_end   = align_up(end, block);
+    auto lease = pool.acquire();
+
+    for(off64_t position = aligned_begin; position < aligned_end; )
+    {
+        auto length = std::min<size_t>(buffer_size, aligned_end - position);
+        auto window_end = position + static_cast<off64_t>(length);
+        auto low = std::max(position, offset), high = std::min(window_end, end);
+
+        // Blocks partially covered by the data keep their existing content.
+        bool partial_head = low > position, partial_tail = high < window_end;
+        if(partial_head)
+            read_block(file, lease.data(), block, position);
+        if(partial_tail and not (partial_head and length == block))
+            read_block(file, lease.data() + length - block, block, window_end - block);
+
+        std::memcpy(lease.data() + (low - position), data.data() + (low - offset), high - low);
+        file.pwrite_all(std::string_view{ lease.data(), length }, position);
+        position = window_end;
+    }
+
+    // Whole-block writes past the end of the data must not extend the file.
+    auto final_size = std::max(original_size, end);
+    if(aligned_end > final_size and ftruncate64(file.descriptor(), final_size) == -1)
+        throw std::system_error(errno, std::generic_category(), "write_direct(): failed to trim the file size");
+    file.invalidate_cache();
+    return data.size();
+}
@@ -0,0 +1,141 @@
+/**
+ * @file directory.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the functions defined in fsop/directory.hpp
+ * @version 1.0
+ * @date 2022-06-21
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/directory.hpp"
+
+#include <list>          // std::list
+#include <mutex>         // std::mutex, std::lock_guard
+#include <unordered_map> // std::unordered_map
+
+#include <cerrno>        // errno
+
+#include <unistd.h>      // close
+#include <sys/stat.h>    // fstat, stat
+
+namespace
+{
+    /**
+     * @brief Process-wide cache of handles of parent directories, keyed by their path.
+     */
+    struct DirectoryCache
+    {
+        using Entry = std::pair<std::string, std::shared_ptr<const int>>;
+
+        std::mutex mutex;
+        /** Cached handles, in order of most recent use. */
+        std::list<Entry> entries;
+        /** Index of cached handles by the path of their directory. */
+        std::unordered_map<std::string, std::list<Entry>::iterator> handles;
+    };
+
+    DirectoryCache& directory_cache()
+    {
+        static DirectoryCache cache;
+        return cache;
+    }
+
+    /**
+     * @brief Opens a handle of a directory, closed once the last reference to it is dropped.
+     *
+     * @param path Path of the directory.
+     * @return {std::shared_ptr<const int>} The handle, or null if the directory cannot be opened.
+     */
+    std::shared_ptr<const int> open_directory(const std::string& path)
+    {
+        // O_PATH handles only need search permission, and do not open the directory for reading.
+        int descriptor = open(path.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+        if(descriptor == -1) return nullptr;
+        return std::shared_ptr<const int>(
+            new int(descriptor),
+            [](const int* descriptor) { close(*descriptor); delete descriptor; }
+        );
+    }
+
+    /**
+     * @brief Checks whether a handle still refers to the directory at a path, which is not
+     *  the case once the directory is renamed, or removed and replaced by another.
+     *
+     * @param handle Handle of the directory.
+     * @param path Path the directory was opened by.
+     * @return {bool} true if the path refers to the same directory as the handle.
+     */
+    bool is_current(int handle, const std::string& path)
+    {
+        struct stat handle_info, path_info;
+        return fstat(handle, &handle_info) == 0 and stat(path.c_str(), &path_info) == 0 and
+            handle_info.st_dev == path_info.st_dev and handle_info.st_ino == path_info.st_ino;
+    }
+}
+
+fsop::ResolvedPath fsop::resolve_path(std::string_view path, bool revalidate)
+{
+    auto separator = path.rfind('/');
+    std::string_view leaf = separator == std::string_view::npos ? path : path.substr(separator + 1);
+
+    // Paths without a parent, or with leaves referring to directories themselves, are left as is.
+    if(separator == std::string_view::npos or leaf.empty() or leaf == "." or leaf == "..")
+        return { nullptr, std::string(path) };
+
+    // The root directory is the parent of its immediate children.
+    std::string parent(path.substr(0, separator == 0 ? 1 : separator));
+
+    auto& cache = directory_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    auto found = cache.handles.find(parent);
+    if(found != cache.handles.end())
+    {
+        auto entry = found->second;
+        if(not revalidate or is_current(*entry->second, parent))
+        {
+            cache.entries.splice(cache.entries.begin(), cache.entries, entry);
+            return { entry->second, std::string(leaf) };
+        }
+        cache.entries.erase(entry);
+        cache.handles.erase(found);
+    }
+
+    auto handle = open_directory(parent);
+    if(not handle) return { nullptr, std::string(path) };
+
+    // The least recently used handle makes way for the new one.
+    if(cache.entries.size() >= max_cached_directories)
+    {
+        cache.handles.erase(cache.entries.back().first);
+        cache.entries.pop_back();
+    }
+    cache.entries.emplace_front(parent, handle);
+    cache.handles.emplace(std::move(parent), cache.entries.begin());
+    return { std::move(handle), std::string(leaf) };
+}
+
+bool fsop::refresh_path(ResolvedPath& resolved, std::string_view path)
+{
+    // Only failed lookups of the leaf component may be due to a stale handle.
+    int error = errno;
+    if(not resolved.handle or (error != ENOENT and error != ENOTDIR and error != ESTALE)) return false;
+
+    auto refreshed = resolve_path(path, true);
+    if(refreshed.handle == resolved.handle)
+    {
+        errno = error;
+        return false;
+    }
+    resolved = std::move(refreshed);
+    return true;
+}
+
+void fsop::clear_directory_cache()
+{
+    auto& cache = directory_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.handles.clear();
+    cache.entries.clear();
+}
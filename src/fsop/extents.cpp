@@ -0,0 +1,156 @@
+/**
+ * @file extents.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the functions defined in fsop/extents.hpp
+ * @version 1.0
+ * @date 2022-06-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/extents.hpp"
+
+#include <cerrno>       // errno, errno macros
+
+#include <string>       // std::string
+#include <algorithm>    // std::min
+#include <system_error> // std::system_error
+
+#include <unistd.h>     // lseek64, SEEK_DATA, SEEK_HOLE
+#include <sys/ioctl.h>  // ioctl
+#include <linux/fs.h>   // FS_IOC_FIEMAP
+#include <linux/fiemap.h> // struct fiemap, FIEMAP_* constants
+
+namespace
+{
+    /**
+     * @brief Moves the offset of a descriptor to the next data or hole at or after a position.
+     *
+     * @param descriptor Descriptor of the file.
+     * @param position Position to search from.
+     * @param whence SEEK_DATA or SEEK_HOLE.
+     * @param end Offset to report if no such region exists before the end of the file.
+     * @return {off64_t} Offset of the region found.
+     */
+    off64_t seek_region(int descriptor, off64_t position, int whence, off64_t end)
+    {
+        auto found = lseek64(descriptor, position, whence);
+        if(found != -1) return std::min(found, end);
+        // No data past the position: the rest of the file is a hole.
+        if(errno == ENXIO) return end;
+        throw std::system_error
+        (
+            errno, std::generic_category(),
+            "map_extents(): failed to locate data or holes (lseek)"
+        );
+    }
+}
+
+size_t fsop::count_extents(File& file)
+{
+    // With no room for extents, FIEMAP only reports the number of extents mapped.
+    struct fiemap request {};
+    request.fm_start  = 0;
+    request.fm_length = FIEMAP_MAX_OFFSET;
+    request.fm_flags  = FIEMAP_FLAG_SYNC;
+    request.fm_extent_count = 0;
+
+    if(ioctl(file.descriptor(), FS_IOC_FIEMAP, &request) == -1)
+    {
+        std::string error_desc = "count_extents(): ";
+        switch(errno)
+        {
+            case EOPNOTSUPP:
+                error_desc += "filesystem does not support mapping extents (FIEMAP)";
+                break;
+            case EBADF:
+                error_desc += "invalid file descriptor";
+                break;
+            case ENOTTY:
+                error_desc += "file does not support mapping extents";
+                break;
+            default:
+                error_desc += "unknown, code " + std::to_string(errno);
+        }
+        throw std::system_error(errno, std::generic_category(), error_desc.c_str());
+    }
+    return request.fm_mapped_extents;
+}
+
+std::vector<fsop::Extent> fsop::map_extents(File& file, off64_t offset, size_t nbytes)
+{
+    auto file_size = static_cast<off64_t>(file.stat().st_size);
+    auto end = file_size;
+    if(nbytes != File::bytes_till_end and offset + static_cast<off64_t>(nbytes) < end)
+        end = offset + nbytes;
+
+    std::vector<Extent> extents;
+    if(offset >= end) return extents;
+
+    auto descriptor = file.descriptor();
+    auto saved_offset = lseek64(descriptor, 0, SEEK_CUR);
+
+    try
+    {
+        for(auto position = offset; position < end; )
+        {
+            auto data_begin = seek_region(descriptor, position, SEEK_DATA, end);
+            if(data_begin > position)
+                extents.push_back({ position, static_cast<size_t>(data_begin - position), false });
+            if(data_begin >= end) break;
+
+            auto data_end = seek_region(descriptor, data_begin, SEEK_HOLE, end);
+            extents.push_back({ data_begin, static_cast<size_t>(data_end - data_begin), true });
+            position = data_end;
+        }
+    }
+    catch(...)
+    {
+        lseek64(descriptor, saved_offset, SEEK_SET);
+        throw;
+    }
+
+    lseek64(descriptor, saved_offset, SEEK_SET);
+    return extents;
+}
+
+size_t fsop::read_sparse(
+    File& file, const std::function<void(std::string_view)>& consumer, size_t chunk_size,
+    off64_t offset, size_t nbytes
+)
+{
+    if(chunk_size == 0)
+        throw std::system_error(EINVAL, std::generic_category(), "read_sparse(): chunk size must be positive");
+
+    auto extents = map_extents(file, offset, nbytes);
+
+    // Holes are served from a single buffer of zeros, data through a reused buffer.
+    std::string zeros, buffer;
+    size_t total = 0;
+    for(const auto& extent : extents)
+    {
+        if(not extent.data)
+        {
+            zeros.resize(std::min(chunk_size, extent.nbytes), '\0');
+            for(size_t remaining = extent.nbytes; remaining > 0; )
+            {
+                auto length = std::min(remaining, zeros.size());
+                consumer(std::string_view{ zeros.data(), length });
+                remaining -= length; total += length;
+            }
+            continue;
+        }
+
+        buffer.resize(std::min(chunk_size, extent.nbytes));
+        for(size_t done = 0; done < extent.nbytes; )
+        {
+            auto length = std::min(extent.nbytes - done, buffer.size());
+            auto nbytes_read = file.pread(buffer.data(), length, extent.offset + done);
+            // The file shrank while reading: stop at the new end.
+            if(nbytes_read == 0) return total;
+            consumer(std::string_view{ buffer.data(), nbytes_read });
+            done += nbytes_read; total += nbytes_read;
+        }
+    }
+    return total;
+}
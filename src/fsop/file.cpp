@@ -12,11 +12,114 @@
 
 #include <cerrno>       // errno, errno macros
 
+#include <chrono>       // std::chrono::steady_clock
+#include <mutex>        // std::mutex, std::unique_lock
+#include <ostream>      // std::ostream
+#include <limits>       // std::numeric_limits
+#include <condition_variable> // std::condition_variable
+#include <algorithm>    // std::min
 #include <system_error> // std::system_error
 
-#include <unistd.h>     // read, write, close, dup
+#include <unistd.h>     // read, write, pread64, pwrite64, close, dup, fsync, fdatasync
+#include <fcntl.h>      // splice, fcntl, F_*PIPE_SZ, fallocate64, posix_fadvise64, readahead
+#include <sys/uio.h>    // preadv64, pwritev64, writev
+#include <sys/sendfile.h> // sendfile64
+#include <poll.h>       // poll, struct pollfd, POLLOUT
 
-fsop::File::File(const File& file_ref)
+std::ostream& fsop::print_write_stats(std::ostream& os, const WriteStats& stats)
+{
+    std::chrono::duration<double, std::milli> stall_time = stats.stall_time;
+    os << stats.bytes << " bytes in " << stats.calls << " write call(s), "
+       << stats.short_writes << " short write(s), " << stats.stalls
+       << " stall(s) waiting " << stall_time.count() << " ms, "
+       << stats.syncs << " sync(s)";
+    return os;
+}
+
+struct fsop::File::SyncState
+{
+    /** Level of durability to maintain. */
+    Durability level;
+    /** Number of written bytes after which to sync (periodic). */
+    size_t     sync_bytes;
+    /** Time after the last sync after which to sync (periodic). */
+    std::chrono::milliseconds sync_interval;
+
+    /** Guards the members below. */
+    std::mutex              lock;
+    /** Notified when a sync completes. */
+    std::condition_variable synced;
+    /** Sequence number of the last accounted write. */
+    unsigned long long      written  = 0;
+    /** Sequence number of the last write made durable. */
+    unsigned long long      durable  = 0;
+    /** Whether a sync is in progress. */
+    bool                    syncing  = false;
+    /** Number of bytes written since the last sync. */
+    size_t                  pending_bytes = 0;
+    /** Completion time of the last sync. */
+    std::chrono::steady_clock::time_point last_sync = std::chrono::steady_clock::now();
+};
+
+namespace
+{
+    /**
+     * @brief Makes writes up to a sequence number durable, joining a sync in progress
+     *        when possible instead of issuing a separate one (group commit).
+     *
+     * @param descriptor Descriptor of the file to sync.
+     * @param state Sync state of the file.
+     * @param guard Lock held over the state, released while syncing.
+     * @param target Sequence number of the last write to make durable.
+     * @param syncs Counter of issued syncs, to update.
+     */
+    template<typename State>
+    void sync_through(int descriptor, State& state, std::unique_lock<std::mutex>& guard,
+                      unsigned long long target, size_t& syncs)
+    {
+        while(state.durable < target)
+        {
+            if(state.syncing) { state.synced.wait(guard); continue; }
+
+            // The sync covers all writes accounted so far, including those of other writers.
+            state.syncing = true;
+            auto covered = state.written; auto covered_bytes = state.pending_bytes;
+            guard.unlock();
+            int status = fdatasync(descriptor); int error = errno;
+            guard.lock();
+            state.syncing = false;
+            if(status == 0)
+            {
+                state.durable = covered; state.pending_bytes -= covered_bytes;
+                state.last_sync = std::chrono::steady_clock::now();
+                ++syncs;
+            }
+            state.synced.notify_all();
+
+            if(status == -1)
+                throw std::system_error(error, std::generic_category(), "commit(): failed to sync file content");
+        }
+    }
+
+    /**
+     * @brief Checks whether periodic durability calls for a sync, i.e. whether the bytes
+     *        written or the time elapsed since the last sync exceed their thresholds.
+     *
+     * @param state Sync state of the file, with its lock held.
+     * @return {bool} true if content is due to be synced.
+     */
+    template<typename State>
+    bool sync_due(const State& state)
+    {
+        if(state.durable == state.written) return false;
+        bool bytes_due = state.sync_bytes > 0 and state.pending_bytes >= state.sync_bytes;
+        bool time_due  = state.sync_interval.count() > 0 and
+            std::chrono::steady_clock::now() - state.last_sync >= state.sync_interval;
+        return bytes_due or time_due;
+    }
+}
+
+fsop::File::File(const File& file_ref) : _sync(file_ref._sync)
 {
     _descriptor = dup(file_ref._descriptor);
     if(_descriptor == invalid_descriptor)
@@ -25,42 +128,61 @@ fsop::File::File(const File& file_ref)
 
 fsop::File& fsop::File::operator=(const File& file_ref)
 {
-    _descriptor = dup(file_ref._descriptor);
-    if(_descriptor == invalid_descriptor)
+    if(this == &file_ref) return *this;
+    int descriptor = dup(file_ref._descriptor);
+    if(descriptor == invalid_descriptor)
         throw std::system_error(errno, std::generic_category(), "failed to copy file descriptor");
+    this->close();
+    _descriptor = descriptor; _info_set = false;
+    _sync = file_ref._sync;
     return *this;
 }
 fsop::File& fsop::File::operator=(File&& tmp_file)
 {
-    _descriptor = tmp_file._descriptor;
+    if(this == &tmp_file) return *this;
+    this->close();
+    _descriptor  = tmp_file._descriptor;
+    _info        = tmp_file._info;
+    _info_set    = tmp_file._info_set;
+    _write_stats = tmp_file._write_stats;
+    _sync = std::move(tmp_file._sync);
     tmp_file._descriptor = invalid_descriptor;
+    tmp_file._info_set = false;
     return *this;
 }
 
-std::string fsop::File::read(size_t nbytes, off64_t offset, int whence)
+off64_t fsop::File::seek(off64_t offset, int whence, std::string_view caller)
 {
-    if(whence != SEEK_CUR or offset != 0)
+    auto new_offset = lseek64(_descriptor, offset, whence);
+    if(new_offset == -1)
     {
-        auto new_offset = lseek64(_descriptor, offset, whence);
-        if(new_offset == -1)
+        std::string error_desc { caller.data(), caller.size() }; error_desc += "(): ";
+        switch (errno)
         {
-            std::string error_desc = "read(): ";
-            switch (errno)
-            {
-            case ESPIPE:
-                error_desc += "seeking on a pipe/FIFO or socket is not allowed";
-                break;
-            default:
-                break;
-            }
-            throw std::system_error(errno, std::generic_category(), error_desc);
+        case ESPIPE:
+            error_desc += "seeking on a pipe/FIFO or socket is not allowed";
+            break;
+        default:
+            break;
         }
+        throw std::system_error(errno, std::generic_category(), error_desc);
     }
-    std::string data; ssize_t nbytes_read;
+    return new_offset;
+}
+
+std::string fsop::File::read(size_t nbytes, off64_t offset, int whence)
+{
+    std::string data;
+    read(data, nbytes, offset, whence);
+    return data;
+}
+
+size_t      fsop::File::read(std::string& buffer, size_t nbytes, off64_t offset, int whence)
+{
     if(nbytes != bytes_till_end)
     {
-        data.resize(nbytes);
-        nbytes_read = ::read(_descriptor, data.data(), nbytes);
+        buffer.resize(nbytes);
+        auto nbytes_read = read(buffer.data(), nbytes, offset, whence);
         if(nbytes_read == 0)
         {
             throw std::system_error
@@ -69,64 +191,550 @@ std::string fsop::File::read(size_t nbytes, off64_t offset, int whence)
                 "read(): offset pointer at end of file (EOF)"
             );
         }
-        else if(nbytes_read == -1)
+        buffer.resize(nbytes_read);
+        return nbytes_read;
+    }
+
+    off64_t position = -1;
+    if(whence != SEEK_CUR or offset != 0)
+        position = seek(offset, whence, "read");
+
+    return read_till_end(buffer, position, false);
+}
+
+size_t      fsop::File::read_till_end(std::string& buffer, off64_t position, bool positional)
+{
+    auto inode_data = stat();
+    bool regular = (inode_data.st_mode & S_IFMT) == S_IFREG;
+
+    // Initial chunk size: the preferred I/O block size, grown geometrically on full reads.
+    size_t chunk = inode_data.st_blksize > 0 ? inode_data.st_blksize : min_read_chunk;
+    // For regular files, expected number of bytes till the end, as per the inode.
+    size_t expected = 0;
+    if(regular)
+    {
+        if(position == -1) position = lseek64(_descriptor, 0, SEEK_CUR);
+        if(position != -1 and inode_data.st_size > position)
+        {
+            expected = inode_data.st_size - position;
+            // Reserve an additional byte, so that a short read detects EOF without another call.
+            chunk = std::min(expected + 1, max_read_chunk);
+        }
+    }
+
+    buffer.clear();
+    size_t length = 0;
+    while(true)
+    {
+        buffer.resize(length + chunk);
+        auto nbytes_read = positional
+            ? ::pread64(_descriptor, buffer.data() + length, chunk, position + length)
+            : ::read   (_descriptor, buffer.data() + length, chunk);
+        if(nbytes_read == -1)
         {
+            if(errno == EINTR) continue;
+            buffer.resize(length);
             throw std::system_error
             (
                 errno, std::generic_category(),
-                "read(): failed to read file content"
+                positional ? "pread(): failed to read file content" : "read(): failed to read file content"
             );
         }
-        else if(static_cast<size_t>(nbytes_read) < nbytes)
-            data.resize(nbytes_read);
+        length += nbytes_read;
+        if(nbytes_read == 0) break;
+        // Short reads indicate EOF for regular files, and drained content for pipes and devices.
+        if(static_cast<size_t>(nbytes_read) < chunk) break;
+        if(length >= expected) chunk = std::min(chunk << 1, max_read_chunk);
+    }
+    buffer.resize(length);
+    return length;
+}
+
+size_t      fsop::File::read(char* buffer, size_t nbytes, off64_t offset, int whence)
+{
+    if(whence != SEEK_CUR or offset != 0)
+        seek(offset, whence, "read");
+
+    auto nbytes_read = ::read(_descriptor, buffer, nbytes);
+    if(nbytes_read == -1)
+    {
+        throw std::system_error
+        (
+            errno, std::generic_category(),
+            "read(): failed to read file content"
+        );
     }
-    else
+    return nbytes_read;
+}
+
+size_t      fsop::File::stream(
+    const std::function<void(std::string_view)>& consumer, size_t chunk_size,
+    size_t nbytes, off64_t offset, int whence
+)
+{
+    if(chunk_size == 0)
+        throw std::system_error(EINVAL, std::generic_category(), "stream(): chunk size must be positive");
+    if(whence != SEEK_CUR or offset != 0)
+        seek(offset, whence, "stream");
+
+    std::string buffer(std::min(chunk_size, nbytes), '\0');
+    size_t total = 0;
+    while(total < nbytes)
+    {
+        auto nbytes_read = read(buffer.data(), std::min(buffer.size(), nbytes - total));
+        if(nbytes_read == 0) break;
+        consumer({ buffer.data(), nbytes_read });
+        total += nbytes_read;
+    }
+    return total;
+}
+
+size_t      fsop::File::send_to(File& target, size_t nbytes, off64_t offset, int whence)
+{
+    if(whence != SEEK_CUR or offset != 0)
+        seek(offset, whence, "send_to");
+    return transfer(target, nbytes, nullptr, "send_to");
+}
+
+size_t      fsop::File::psend_to(File& target, size_t nbytes, off64_t offset)
+{
+    return transfer(target, nbytes, &offset, "psend_to");
+}
+
+size_t      fsop::File::transfer(File& target, size_t nbytes, off64_t* position, std::string_view caller)
+{
+    // Largest transfer requested in a single call.
+    static constexpr size_t max_transfer = 0x7ffff000;
+
+    bool from_pipe = (stat().st_mode & S_IFMT) == S_IFIFO;
+    if(from_pipe and position != nullptr)
+        throw std::system_error(ESPIPE, std::generic_category(), std::string(caller) + "(): positional transfers from a pipe/FIFO are not allowed");
+
+    size_t total = 0; std::string buffer; bool in_kernel = true;
+    while(total < nbytes)
     {
-        char buffer[1024];
-        while((nbytes_read = ::read(_descriptor, buffer, sizeof(buffer))) )
+        size_t request = std::min(nbytes - total, max_transfer);
+        ssize_t nbytes_sent;
+        if(in_kernel)
+        {
+            nbytes_sent = from_pipe
+                ? splice(_descriptor, nullptr, target._descriptor, nullptr, request, SPLICE_F_MOVE)
+                : sendfile64(target._descriptor, _descriptor, position, request);
+            // Files unsupported by the kernel are rejected before any transfer: copy instead.
+            if(nbytes_sent == -1 and total == 0 and (errno == EINVAL or errno == ENOSYS or errno == EOPNOTSUPP))
+            {
+                in_kernel = false;
+                continue;
+            }
+        }
+        else
         {
-            if(nbytes_read == -1)
+            if(buffer.empty()) buffer.resize(std::min(request, size_t{ 1 } << 16));
+            request = std::min(request, buffer.size());
+            nbytes_sent = position
+                ? ::pread64(_descriptor, buffer.data(), request, *position)
+                : ::read   (_descriptor, buffer.data(), request);
+            if(nbytes_sent > 0)
             {
-                throw std::system_error
-                (
-                    errno, std::generic_category(),
-                    "read(): failed to read file content"
-                );
+                if(position) *position += nbytes_sent;
+                for(size_t written = 0; written < static_cast<size_t>(nbytes_sent); )
+                    written += target.write(std::string_view{ buffer.data() + written, nbytes_sent - written });
             }
-            data.append(buffer, nbytes_read);
-            if(static_cast<size_t>(nbytes_read) < sizeof(buffer)) break;
         }
+        if(nbytes_sent == -1)
+        {
+            if(errno == EINTR) continue;
+            throw std::system_error
+            (
+                errno, std::generic_category(),
+                std::string(caller) + "(): failed to transfer file content"
+            );
+        }
+        total += nbytes_sent;
+        if(nbytes_sent == 0 or (from_pipe and static_cast<size_t>(nbytes_sent) < request)) break;
     }
-    return data;
+    return total;
 }
 
 size_t      fsop::File::write(std::string_view data, off64_t offset, int whence)
 {
     if(whence != SEEK_CUR or offset != 0)
+        seek(offset, whence, "write");
+
+    auto nbytes_written = ::write(_descriptor, data.data(), data.size());
+    if(nbytes_written == -1)
+        throw std::system_error
+        (
+            errno, std::generic_category(),
+            "write(): failed to write content to file"
+        );
+    account_written(nbytes_written);
+    return nbytes_written;
+}
+
+size_t      fsop::File::write_all(std::string_view data, off64_t offset, int whence)
+{
+    if(whence != SEEK_CUR or offset != 0)
+        seek(offset, whence, "write_all");
+    return write_fully(data, nullptr, "write_all");
+}
+
+size_t      fsop::File::pwrite_all(std::string_view data, off64_t offset)
+{
+    return write_fully(data, &offset, "pwrite_all");
+}
+
+size_t      fsop::File::write_fully(std::string_view data, const off64_t* position, std::string_view caller)
+{
+    auto mode = stat().st_mode;
+    bool is_stream = S_ISFIFO(mode) or S_ISSOCK(mode);
+
+    size_t total = 0;
+    while(total < data.size())
     {
-        auto new_offset = lseek64(_descriptor, offset, whence);
-        if(new_offset == -1)
+        auto remaining = data.size() - total;
+        auto nbytes = position != nullptr
+            ? ::pwrite64(_descriptor, data.data() + total, remaining, *position + total)
+            : ::write   (_descriptor, data.data() + total, remaining);
+        ++_write_stats.calls;
+
+        if(nbytes == -1)
         {
-            std::string error_desc = "write(): ";
-            switch (errno)
-            {
+            if(errno == EINTR) continue;
+            if(errno == EAGAIN or errno == EWOULDBLOCK) { wait_writable(caller); continue; }
+
+            std::string error_desc { caller.data(), caller.size() };
+            error_desc += "(): failed to write content to file";
+            throw std::system_error(errno, std::generic_category(), error_desc);
+        }
+        total += nbytes; _write_stats.bytes += nbytes;
+        if(static_cast<size_t>(nbytes) < remaining)
+        {
+            ++_write_stats.short_writes;
+            // A short write to a stream means its buffer is full: wait for the consumer
+            // to drain it, rather than retrying with a write accepting few bytes.
+            if(is_stream) wait_writable(caller);
+        }
+    }
+    account_written(total);
+    return total;
+}
+
+void        fsop::File::wait_writable(std::string_view caller)
+{
+    struct pollfd request { _descriptor, POLLOUT, 0 };
+    auto start = std::chrono::steady_clock::now();
+
+    int status;
+    while((status = poll(&request, 1, -1)) == -1 and errno == EINTR);
+    if(status == -1)
+    {
+        std::string error_desc { caller.data(), caller.size() };
+        error_desc += "(): failed to wait for the file to become writable";
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+
+    ++_write_stats.stalls;
+    _write_stats.stall_time += std::chrono::steady_clock::now() - start;
+    // Errors (such as the reader closing a pipe) are reported by the next write.
+}
+
+size_t      fsop::File::pread(std::string& buffer, size_t nbytes, off64_t offset)
+{
+    if(nbytes != bytes_till_end)
+    {
+        buffer.resize(nbytes);
+        auto nbytes_read = pread(buffer.data(), nbytes, offset);
+        if(nbytes_read == 0)
+        {
+            throw std::system_error
+            (
+                errno, std::generic_category(),
+                "pread(): offset at end of file (EOF)"
+            );
+        }
+        buffer.resize(nbytes_read);
+        return nbytes_read;
+    }
+
+    return read_till_end(buffer, offset, true);
+}
+
+size_t      fsop::File::pread(char* buffer, size_t nbytes, off64_t offset)
+{
+    auto nbytes_read = ::pread64(_descriptor, buffer, nbytes, offset);
+    if(nbytes_read == -1)
+    {
+        std::string error_desc = "pread(): ";
+        switch (errno)
+        {
+        case ESPIPE:
+            error_desc += "positional reads on a pipe/FIFO or socket are not allowed";
+            break;
+        case EINVAL:
+            error_desc += "negative offset specified";
+            break;
+        default:
+            error_desc += "failed to read file content";
+            break;
+        }
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+    return nbytes_read;
+}
+
+size_t      fsop::File::pwrite(std::string_view data, off64_t offset)
+{
+    auto nbytes_written = ::pwrite64(_descriptor, data.data(), data.size(), offset);
+    if(nbytes_written == -1)
+    {
+        std::string error_desc = "pwrite(): ";
+        switch (errno)
+        {
+        case ESPIPE:
+            error_desc += "positional writes on a pipe/FIFO or socket are not allowed";
+            break;
+        case EINVAL:
+            error_desc += "negative offset specified";
+            break;
+        default:
+            error_desc += "failed to write content to file";
+            break;
+        }
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+    account_written(nbytes_written);
+    return nbytes_written;
+}
+
+size_t      fsop::File::preadv(const struct iovec* vectors, int count, off64_t offset)
+{
+    auto nbytes_read = ::preadv64(_descriptor, vectors, count, offset);
+    if(nbytes_read == -1)
+    {
+        std::string error_desc = "preadv(): ";
+        switch (errno)
+        {
+        case ESPIPE:
+            error_desc += "positional reads on a pipe/FIFO or socket are not allowed";
+            break;
+        case EINVAL:
+            error_desc += "negative offset or invalid number of regions specified";
+            break;
+        default:
+            error_desc += "failed to read file content";
+            break;
+        }
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+    return nbytes_read;
+}
+
+size_t      fsop::File::pwritev(const struct iovec* vectors, int count, off64_t offset)
+{
+    auto nbytes_written = ::pwritev64(_descriptor, vectors, count, offset);
+    if(nbytes_written == -1)
+    {
+        std::string error_desc = "pwritev(): ";
+        switch (errno)
+        {
+        case ESPIPE:
+            error_desc += "positional writes on a pipe/FIFO or socket are not allowed";
+            break;
+        case EINVAL:
+            error_desc += "negative offset or invalid number of regions specified";
+            break;
+        default:
+            error_desc += "failed to write content to file";
+            break;
+        }
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+    account_written(nbytes_written);
+    return nbytes_written;
+}
+
+size_t      fsop::File::writev(const struct iovec* vectors, int count)
+{
+    auto nbytes_written = ::writev(_descriptor, vectors, count);
+    if(nbytes_written == -1)
+        throw std::system_error
+        (
+            errno, std::generic_category(),
+            "writev(): failed to write content to file"
+        );
+    account_written(nbytes_written);
+    return nbytes_written;
+}
+
+void        fsop::File::set_durability(Durability level, size_t sync_bytes, std::chrono::milliseconds sync_interval)
+{
+    if(level == Durability::periodic and sync_bytes == 0 and sync_interval.count() <= 0)
+        throw std::system_error
+        (
+            EINVAL, std::generic_category(),
+            "set_durability(): periodic durability requires a byte count or time interval"
+        );
+
+    _sync = std::make_shared<SyncState>();
+    _sync->level = level; _sync->sync_bytes = sync_bytes; _sync->sync_interval = sync_interval;
+}
+
+fsop::Durability fsop::File::durability() const noexcept
+{
+    return _sync ? _sync->level : Durability::none;
+}
+
+void        fsop::File::account_written(size_t nbytes)
+{
+    if(not _sync or _sync->level == Durability::none) return;
+
+    auto& state = *_sync;
+    std::unique_lock guard { state.lock };
+    ++state.written; state.pending_bytes += nbytes;
+
+    if(state.level == Durability::periodic and sync_due(state))
+        sync_through(_descriptor, state, guard, state.written, _write_stats.syncs);
+}
+
+void        fsop::File::commit()
+{
+    if(not _sync or _sync->level == Durability::none) return;
+
+    auto& state = *_sync;
+    std::unique_lock guard { state.lock };
+    // Periodic durability syncs only on its thresholds, which may have elapsed since the last write.
+    if(state.level == Durability::batch or sync_due(state))
+        sync_through(_descriptor, state, guard, state.written, _write_stats.syncs);
+}
+
+void        fsop::File::settle()
+{
+    if(not _sync or _sync->level == Durability::none) return;
+
+    auto& state = *_sync;
+    std::unique_lock guard { state.lock };
+    sync_through(_descriptor, state, guard, state.written, _write_stats.syncs);
+}
+
+void        fsop::File::allocate(off64_t offset, size_t nbytes, int mode)
+{
+    if(fallocate64(_descriptor, mode, offset, nbytes) == -1)
+    {
+        std::string error_desc = "allocate(): ";
+        switch(errno)
+        {
+            case EOPNOTSUPP:
+                error_desc += "allocation mode not supported by the filesystem";
+                break;
+            case ENOSPC:
+                error_desc += "insufficient space on the device";
+                break;
             case ESPIPE:
-                error_desc += "seeking on a pipe/FIFO or socket is not allowed";
+            case ENODEV:
+                error_desc += "allocation is supported only for regular files";
+                break;
+            case EFBIG:
+                error_desc += "range exceeds the maximum file size";
                 break;
             default:
+                error_desc += "unknown, code " + std::to_string(errno);
+        }
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+    invalidate_cache();
+}
+
+void        fsop::File::advise(off64_t offset, size_t nbytes, int advice)
+{
+    // posix_fadvise reports failures through its return value, not errno.
+    auto status = posix_fadvise64(_descriptor, offset, nbytes, advice);
+    if(status != 0)
+    {
+        std::string error_desc = "advise(): ";
+        switch(status)
+        {
+            case ESPIPE:
+                error_desc += "advice is not supported for pipes/FIFOs";
                 break;
-            }
-            throw std::system_error(errno, std::generic_category(), error_desc);
+            case EINVAL:
+                error_desc += "invalid advice, or file type not supported";
+                break;
+            default:
+                error_desc += "unknown, code " + std::to_string(status);
         }
+        throw std::system_error(status, std::generic_category(), error_desc);
     }
-    auto nbytes_written = ::write(_descriptor, data.data(), data.size());
-    if(nbytes_written == -1)
+}
+
+void        fsop::File::readahead(off64_t offset, size_t nbytes)
+{
+    if(::readahead(_descriptor, offset, nbytes) == -1)
         throw std::system_error
         (
             errno, std::generic_category(),
-            "write(): failed to write content to file"
+            "readahead(): failed to initiate reading ahead (possibly not a regular file)"
+        );
+}
+
+void        fsop::File::sync_data()
+{
+    if(fdatasync(_descriptor) == -1)
+        throw std::system_error(errno, std::generic_category(), "sync_data(): failed to sync file content");
+    ++_write_stats.syncs;
+}
+
+void        fsop::File::sync()
+{
+    if(fsync(_descriptor) == -1)
+        throw std::system_error(errno, std::generic_category(), "sync(): failed to sync file");
+    ++_write_stats.syncs;
+}
+
+size_t      fsop::File::pipe_capacity()
+{
+    int capacity = fcntl(_descriptor, F_GETPIPE_SZ);
+    if(capacity == -1)
+        throw std::system_error
+        (
+            errno, std::generic_category(),
+            "pipe_capacity(): failed to retrieve capacity (possibly not a pipe)"
+        );
+    return capacity;
+}
+
+size_t      fsop::File::set_pipe_capacity(size_t capacity)
+{
+    // Capacities are passed to the kernel as an int, hence larger values would be truncated.
+    if(capacity > static_cast<size_t>(std::numeric_limits<int>::max()))
+        throw std::system_error
+        (
+            EINVAL, std::generic_category(),
+            "set_pipe_capacity(): capacity exceeds the largest supported value ("
+            + std::to_string(std::numeric_limits<int>::max()) + " bytes)"
         );
-    else return nbytes_written;
+    int new_capacity = fcntl(_descriptor, F_SETPIPE_SZ, static_cast<int>(capacity));
+    if(new_capacity == -1)
+    {
+        std::string error_desc = "set_pipe_capacity(): ";
+        switch(errno)
+        {
+            case EBADF:
+            case EINVAL:
+                error_desc += "not a pipe, or capacity out of range";
+                break;
+            case EPERM:
+                error_desc += "capacity exceeds the limit for unprivileged processes (/proc/sys/fs/pipe-max-size)";
+                break;
+            case EBUSY:
+                error_desc += "capacity is smaller than the content currently held by the pipe";
+                break;
+            default:
+                error_desc += "unknown, code " + std::to_string(errno);
+        }
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+    return new_capacity;
 }
 
 struct stat64 fsop::File::stat()
@@ -146,6 +754,9 @@ void fsop::File::close() noexcept
 {
     if(_descriptor > 2)
     {
+        // Content still pending under periodic durability gets a final sync; use {settle} to observe failures.
+        try { settle(); }
+        catch(std::system_error&) {}
         ::close(_descriptor);
         _descriptor = invalid_descriptor;
     }
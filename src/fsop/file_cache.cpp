@@ -0,0 +1,126 @@
+/**
+ * @file file_cache.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the structure defined in fsop/file_cache.hpp
+ * @version 1.0
+ * @date 2022-06-22
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/file_cache.hpp"
+#include "fsop/directory.hpp"  // fsop::resolve_path
+
+#include <cerrno>              // errno, EMFILE
+#include <limits>              // std::numeric_limits
+#include <algorithm>           // std::min, std::max
+#include <system_error>        // std::system_error
+
+#include <fcntl.h>             // fstatat64, O_* constants
+#include <sys/stat.h>          // struct stat64
+#include <sys/resource.h>      // getrlimit, RLIMIT_NOFILE
+
+fsop::FileCache::FileCache(size_t capacity) : _capacity(std::max<size_t>(capacity, 1))
+{
+    // Half the descriptors are left to the rest of the process.
+    struct rlimit limit;
+    if(getrlimit(RLIMIT_NOFILE, &limit) == 0 and limit.rlim_cur != RLIM_INFINITY)
+        _capacity = std::max<size_t>(std::min<size_t>(_capacity, limit.rlim_cur / 2), 1);
+}
+
+std::shared_ptr<fsop::File> fsop::FileCache::open(std::string_view path, int open_options)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Truncation and (exclusive) creation take effect on every open, so such files are not shared.
+    if(open_options & (O_TRUNC | O_CREAT | O_EXCL))
+    {
+        ++_stats.bypasses;
+        return std::make_shared<File>(open_evicting(path, open_options));
+    }
+
+    Key key { std::string(path), open_options };
+    auto found = _index.find(key);
+    if(found != _index.end())
+    {
+        auto entry = found->second;
+        auto& file = entry->second;
+
+        // The path may since have been replaced (renamed over, or deleted and recreated).
+        auto resolved = resolve_path(path);
+        struct stat64 path_info;
+        auto file_info = file->stat();
+        if(fstatat64(resolved.directory(), resolved.name.c_str(), &path_info, 0) == 0 and
+           path_info.st_dev == file_info.st_dev and path_info.st_ino == file_info.st_ino)
+        {
+            ++_stats.hits;
+            // Content may have changed since the file was last used.
+            file->invalidate_cache();
+            _entries.splice(_entries.begin(), _entries, entry);
+            return file;
+        }
+        ++_stats.invalidations;
+        _entries.erase(entry);
+        _index.erase(found);
+    }
+
+    ++_stats.misses;
+    auto file = std::make_shared<File>(open_evicting(path, open_options));
+    if(_entries.size() >= _capacity)
+    {
+        ++_stats.evictions;
+        _index.erase(_entries.back().first);
+        _entries.pop_back();
+    }
+    _entries.emplace_front(key, file);
+    _index.emplace(std::move(key), _entries.begin());
+    return file;
+}
+
+fsop::File fsop::FileCache::open_evicting(std::string_view path, int open_options)
+{
+    while(true)
+    {
+        try
+        {
+            return File::open_file(path, open_options);
+        }
+        catch(std::system_error& error)
+        {
+            if(error.code().value() != EMFILE or _entries.empty()) throw;
+            ++_stats.evictions;
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+    }
+}
+
+void fsop::FileCache::invalidate(std::string_view path)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for(auto entry = _index.lower_bound({ std::string(path), std::numeric_limits<int>::min() });
+        entry != _index.end() and entry->first.first == path; )
+    {
+        _entries.erase(entry->second);
+        entry = _index.erase(entry);
+    }
+}
+
+void fsop::FileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _index.clear();
+    _entries.clear();
+}
+
+size_t fsop::FileCache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+fsop::FileCacheStats fsop::FileCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
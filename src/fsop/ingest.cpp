@@ -0,0 +1,177 @@
+/**
+ * @file ingest.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the functions defined in fsop/ingest.hpp
+ * @version 1.0
+ * @date 2022-06-14
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/ingest.hpp"
+
+#include <array>              // std::array
+#include <cstdint>            // std::uint64_t
+#include <mutex>              // std::mutex, std::unique_lock
+#include <string>             // std::string
+#include <thread>             // std::thread
+#include <exception>          // std::exception_ptr, std::current_exception
+#include <system_error>       // std::system_error
+#include <condition_variable> // std::condition_variable
+
+#include <poll.h>             // poll, struct pollfd, POLLIN
+#include <unistd.h>           // close, write
+#include <sys/eventfd.h>      // eventfd, EFD_CLOEXEC
+
+namespace
+{
+    /**
+     * @brief A buffer shared between the reading thread and the consumer.
+     */
+    struct Slot
+    {
+        /** Storage for the chunk. */
+        std::string data;
+        /** Number of valid bytes in the storage. */
+        size_t      size   = 0;
+        /** Whether the slot holds a chunk yet to be consumed. */
+        bool        filled = false;
+    };
+
+    /**
+     * @brief An eventfd signalling cancellation to a thread blocked waiting for input,
+     *  closed once the object runs out of scope.
+     */
+    struct CancelEvent
+    {
+        CancelEvent() : descriptor(eventfd(0, EFD_CLOEXEC))
+        {
+            if(descriptor == -1)
+                throw std::system_error(errno, std::generic_category(), "ingest(): failed to create cancellation event");
+        }
+        CancelEvent(const CancelEvent&) = delete;
+        CancelEvent& operator=(const CancelEvent&) = delete;
+        ~CancelEvent() { close(descriptor); }
+
+        /** Wakes up waiters, permanently. */
+        void signal() noexcept
+        {
+            std::uint64_t count = 1;
+            [[maybe_unused]] auto status = write(descriptor, &count, sizeof(count));
+        }
+
+        /**
+         * @brief Waits until a descriptor has input (or is at EOF or failed), or the event is signalled.
+         *
+         * @param source Descriptor to wait for input on.
+         * @return {bool} true if the source is ready, false if the event was signalled.
+         */
+        bool wait_readable(int source) const
+        {
+            struct pollfd requests[2] = { { source, POLLIN, 0 }, { descriptor, POLLIN, 0 } };
+            while(poll(requests, 2, -1) == -1)
+                if(errno != EINTR)
+                    throw std::system_error(errno, std::generic_category(), "ingest(): failed to wait for input (poll)");
+            return not (requests[1].revents & POLLIN);
+        }
+
+        int descriptor;
+    };
+}
+
+size_t fsop::ingest(
+    File& source, const std::function<void(std::string_view)>& consumer, size_t chunk_size
+)
+{
+    if(chunk_size == 0)
+        throw std::system_error(EINVAL, std::generic_category(), "ingest(): chunk size must be positive");
+
+    std::array<Slot, 2> slots;
+    for(auto& slot : slots) slot.data.resize(chunk_size);
+
+    std::mutex              lock;
+    std::condition_variable changed;
+    bool                    cancelled = false;
+    std::exception_ptr      read_error;
+    // Interrupts the reader when blocked waiting for input, as it cannot observe 'cancelled' meanwhile.
+    CancelEvent             cancel;
+
+    // Fills the slots alternately, until EOF. An empty filled slot marks the end.
+    std::thread reader([&] {
+        for(size_t index = 0; ; index ^= 1)
+        {
+            auto& slot = slots[index];
+            {
+                std::unique_lock guard { lock };
+                changed.wait(guard, [&] { return not slot.filled or cancelled; });
+                if(cancelled) return;
+            }
+
+            size_t size = 0;
+            try
+            {
+                size_t nbytes = 1;
+                while(size < chunk_size and nbytes > 0)
+                {
+                    if(not cancel.wait_readable(source.descriptor())) return;
+                    nbytes = source.read(slot.data.data() + size, chunk_size - size);
+                    size += nbytes;
+                }
+            }
+            catch(...)
+            {
+                std::unique_lock guard { lock };
+                read_error = std::current_exception();
+                size = 0;
+            }
+
+            {
+                std::unique_lock guard { lock };
+                slot.size = size; slot.filled = true;
+            }
+            changed.notify_all();
+            if(size < chunk_size) return;
+        }
+    });
+
+    size_t total = 0;
+    try
+    {
+        for(size_t index = 0; ; index ^= 1)
+        {
+            auto& slot = slots[index];
+            {
+                std::unique_lock guard { lock };
+                changed.wait(guard, [&] { return slot.filled; });
+            }
+            if(slot.size == 0) break;
+
+            consumer(std::string_view{ slot.data.data(), slot.size });
+            total += slot.size;
+
+            bool last = slot.size < chunk_size;
+            {
+                std::unique_lock guard { lock };
+                slot.filled = false;
+            }
+            changed.notify_all();
+            if(last) break;
+        }
+    }
+    catch(...)
+    {
+        // Stop the reader before the buffers go out of scope.
+        {
+            std::unique_lock guard { lock };
+            cancelled = true;
+        }
+        changed.notify_all();
+        cancel.signal();
+        reader.join();
+        throw;
+    }
+
+    reader.join();
+    if(read_error) std::rethrow_exception(read_error);
+    return total;
+}
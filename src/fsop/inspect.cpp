@@ -10,38 +10,53 @@
 
 #include "fsop/inspect.hpp"
 #include "fsop/utilities.hpp"
+#include "fsop/directory.hpp"  // fsop::resolve_path
 
-#include <pwd.h>           // struct passwd, getpwuid
-#include <grp.h>           // struct group, getgrgid
-#include <sys/sysmacros.h> // major, minor
+#include <ctime>           // std::time_t, localtime_r
+#include <algorithm>       // std::max
 
-auto fsop::inspect_file(std::string_view path, bool follow_symlinks) -> fsop::stat_info
+#include <pwd.h>           // struct passwd, getpwuid_r
+#include <grp.h>           // struct group, getgrgid_r
+#include <sys/sysmacros.h> // major, minor, makedev
+#include <fcntl.h>         // openat, fstatat, fcntl, F_GETPIPE_SZ
+#include <unistd.h>        // close, sysconf
+
+auto fsop::inspect_file(
+    std::string_view path, bool follow_symlinks, unsigned int fields, bool dont_sync
+) -> fsop::stat_info
 {
     stat_info inode_data; int status = 0;
 
-    if(follow_symlinks)
-    {
-        status = stat(path.data(), &std::get<struct stat>(inode_data));
-    }
-    else
+    // Only the leaf component is looked up, relative to a cached handle of the parent directory.
+    auto resolved = resolve_path(path);
+    // Use AT_SYMLINK_NOFOLLOW (as lstat*() does) to prevent resolution of symbolic links.
+    int flags = follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+
+    // Request only the required fields, optionally accepting locally cached attributes.
+    auto query = [&] {
+        return statx(
+            resolved.directory(), resolved.name.c_str(),
+            flags | (dont_sync ? AT_STATX_DONT_SYNC : AT_STATX_SYNC_AS_STAT),
+            fields, &inode_data.emplace<struct statx>()
+        );
+    };
+    status = query();
+    // The lookup may have failed through a stale handle of the parent directory.
+    if(status == -1 and refresh_path(resolved, path)) status = query();
+    if(status == 0) return inode_data;
+
+    // Kernels without statx (before 4.11) are served by fstatat, which retrieves all fields.
+    if(errno == ENOSYS)
     {
-        // Use lstat*() instead of stat(0 to prevent resolution of symbolic links.
-        status = lstat(path.data(), &std::get<struct stat>(inode_data));
+        status = fstatat(resolved.directory(), resolved.name.c_str(), &inode_data.emplace<struct stat>(), flags);
+        if(status == 0) return inode_data;
     }
-    if(status == 0) return inode_data;
 
     // If the failure was due to overflow on the buffer provided to hold the data ...
     if(errno == EOVERFLOW)
     {
         // ... retry using a call to a stat function which returns data in a larger structure.
-        if(follow_symlinks)
-        {
-            status = stat64(path.data(), &std::get<struct stat64>(inode_data));
-        }
-        else
-        {
-            status = lstat64(path.data(), &std::get<struct stat64>(inode_data));
-        }
+        status = fstatat64(resolved.directory(), resolved.name.c_str(), &inode_data.emplace<struct stat64>(), flags);
         if(status == 0) return inode_data;
     }
 
@@ -82,82 +97,226 @@ auto fsop::inspect_file(std::string_view path, bool follow_symlinks) -> fsop::st
     throw std::system_error(errno, std::generic_category(), error_desc.c_str());
 }
 
-std::ostream& fsop::print_stat_info(std::ostream& os, const fsop::stat_info& info)
+namespace
 {
-    const std::string::size_type spc_w = 30;
+    /** Width of the label column in printed information. */
+    constexpr std::string::size_type spc_w = 30;
 
-    struct passwd* pwd; struct group* grp;
-    struct stat64 fileinfo;
-    if(std::holds_alternative<struct stat>(info))
+    /**
+     * @brief Converts information from a stat structure to a statx structure, marking the basic fields as present.
+     *
+     * @param info Information as returned by a stat function.
+     * @return {struct statx} The equivalent statx information.
+     */
+    template<typename StatType>
+    struct statx to_statx(const StatType& info)
+    {
+        struct statx extended {};
+        extended.stx_mask      = STATX_BASIC_STATS;
+        extended.stx_dev_major = major(info.st_dev);
+        extended.stx_dev_minor = minor(info.st_dev);
+        extended.stx_ino       = info.st_ino;
+        extended.stx_mode      = info.st_mode;
+        extended.stx_nlink     = info.st_nlink;
+        extended.stx_uid       = info.st_uid;
+        extended.stx_gid       = info.st_gid;
+        extended.stx_size      = info.st_size;
+        extended.stx_blksize   = info.st_blksize;
+        extended.stx_blocks    = info.st_blocks;
+        extended.stx_atime.tv_sec = info.st_atime;
+        extended.stx_mtime.tv_sec = info.st_mtime;
+        extended.stx_ctime.tv_sec = info.st_ctime;
+        return extended;
+    }
+
+    /**
+     * @brief Prints a timestamp in the layout used for inspected information.
+     *
+     * @param os The output stream to write content to.
+     * @param timestamp The timestamp to print.
+     */
+    void print_time(std::ostream& os, const struct statx_timestamp& timestamp)
+    {
+        std::time_t seconds = timestamp.tv_sec; struct tm local_time;
+        os << std::put_time(localtime_r(&seconds, &local_time), "%a, %b %e, %Y, at %H:%M:%S %Z");
+    }
+
+    /**
+     * @brief Returns the size of the buffer for reentrant user and group lookups.
+     *
+     * @param limit Limit to query (_SC_GETPW_R_SIZE_MAX or _SC_GETGR_R_SIZE_MAX).
+     * @return {size_t} Suggested buffer size, in bytes.
+     */
+    size_t lookup_buffer_size(int limit)
     {
-        auto _fileinfo = std::get<struct stat>(info);
-        fileinfo.st_dev     = _fileinfo.st_dev;
-        fileinfo.st_ino     = _fileinfo.st_ino;
-        fileinfo.st_mode    = _fileinfo.st_mode;
-        fileinfo.st_nlink   = _fileinfo.st_nlink;
-        fileinfo.st_uid     = _fileinfo.st_uid;
-        fileinfo.st_gid     = _fileinfo.st_gid;
-        fileinfo.st_rdev    = _fileinfo.st_rdev;
-        fileinfo.st_size    = _fileinfo.st_size;
-        fileinfo.st_atime   = _fileinfo.st_atime;
-        fileinfo.st_mtime   = _fileinfo.st_mtime;
-        fileinfo.st_ctime   = _fileinfo.st_ctime;
-        fileinfo.st_blksize = _fileinfo.st_blksize;
-        fileinfo.st_blocks  = _fileinfo.st_blocks;
+        auto size = sysconf(limit);
+        return size > 0 ? size : 16384;
     }
-    else fileinfo = std::get<struct stat64>(info);
+}
 
-    os << std::setw(spc_w) << "Inode number"             << " │ " << fileinfo.st_ino << '\n';
-    os << std::setw(spc_w) << "Inode link count"         << " │ " << fileinfo.st_nlink << '\n';
+mode_t fsop::file_mode(const stat_info& info)
+{
+    if(std::holds_alternative<struct stat>(info))
+        return std::get<struct stat>(info).st_mode;
+    else if(std::holds_alternative<struct stat64>(info))
+        return std::get<struct stat64>(info).st_mode;
+    else return std::get<struct statx>(info).stx_mode;
+}
 
+std::ostream& fsop::print_stat_info(std::ostream& os, const fsop::stat_info& info, unsigned int fields)
+{
+
+    // Reentrant lookups, as information may be printed from several threads at once.
+    struct passwd pwd_entry, *pwd = nullptr; struct group grp_entry, *grp = nullptr;
+    struct statx fileinfo;
+    if(std::holds_alternative<struct stat>(info))
+        fileinfo = to_statx(std::get<struct stat>(info));
+    else if(std::holds_alternative<struct stat64>(info))
+        fileinfo = to_statx(std::get<struct stat64>(info));
+    else fileinfo = std::get<struct statx>(info);
+
+    // Prints the label of a requested field, returning whether the field is available to print.
+    auto field = [&](const char* label, unsigned int mask) {
+        if(not (fields & mask)) return false;
+        os << std::setw(spc_w) << label << " │ ";
+        if(fileinfo.stx_mask & mask) return true;
+        os << "unavailable (not reported by the filesystem)\n";
+        return false;
+    };
+
+    if(field("Inode number", STATX_INO))         os << fileinfo.stx_ino << '\n';
+    if(field("Inode link count", STATX_NLINK))   os << fileinfo.stx_nlink << '\n';
+
+    auto device = makedev(fileinfo.stx_dev_major, fileinfo.stx_dev_minor);
     os << std::setw(spc_w) << "Device identifier"        << " │ " << std::hex << std::uppercase
-       << std::showbase << fileinfo.st_dev  << " (major/class = " << major(fileinfo.st_dev)
-       << ", minor/instance = " << minor(fileinfo.st_dev) << std::dec << ")\n";
+       << std::showbase << device << " (major/class = " << fileinfo.stx_dev_major
+       << ", minor/instance = " << fileinfo.stx_dev_minor << std::dec << ")\n";
 
-    os << std::setw(spc_w) << "File owner (user)"        << " │ ";
-    if((pwd = getpwuid(fileinfo.st_uid))) { os << pwd->pw_name << ", "; }
-    os << "UID " << fileinfo.st_uid << '\n';
-    os << std::setw(spc_w) << "File owner group"         << " │ ";
-    if((grp = getgrgid(fileinfo.st_gid))) { os << grp->gr_name << ", "; }
-    os << "GID " << fileinfo.st_gid << '\n';
+    if(field("File owner (user)", STATX_UID))
+    {
+        std::string buffer(lookup_buffer_size(_SC_GETPW_R_SIZE_MAX), '\0');
+        getpwuid_r(fileinfo.stx_uid, &pwd_entry, buffer.data(), buffer.size(), &pwd);
+        if(pwd) { os << pwd->pw_name << ", "; }
+        os << "UID " << fileinfo.stx_uid << '\n';
+    }
+    if(field("File owner group", STATX_GID))
+    {
+        std::string buffer(lookup_buffer_size(_SC_GETGR_R_SIZE_MAX), '\0');
+        getgrgid_r(fileinfo.stx_gid, &grp_entry, buffer.data(), buffer.size(), &grp);
+        if(grp) { os << grp->gr_name << ", "; }
+        os << "GID " << fileinfo.stx_gid << '\n';
+    }
 
     char file_type = '-';
-    os << std::setw(spc_w) << "File type"                << " │ ";
-    switch(fileinfo.st_mode & S_IFMT)
+    switch(fileinfo.stx_mode & S_IFMT)
+    {
+        case S_IFBLK : file_type = 'b'; break;
+        case S_IFCHR : file_type = 'c'; break;
+        case S_IFDIR : file_type = 'd'; break;
+        case S_IFIFO : file_type = 'p'; break;
+        case S_IFLNK : file_type = 'l'; break;
+        case S_IFREG : file_type = '-'; break;
+        case S_IFSOCK: file_type = 's'; break;
+    }
+    if(field("File type", STATX_TYPE))
     {
-        case S_IFBLK : os << "Block device";      file_type = 'b'; break;
-        case S_IFCHR : os << "Character device";  file_type = 'c'; break;
-        case S_IFDIR : os << "Directory";         file_type = 'd'; break;
-        case S_IFIFO : os << "Named pipe / FIFO"; file_type = 'p'; break;
-        case S_IFLNK : os << "Symbolic link";     file_type = 'l'; break;
-        case S_IFREG : os << "Regular file";      file_type = '-'; break;
-        case S_IFSOCK: os << "Socket";            file_type = 's'; break;
+        switch(fileinfo.stx_mode & S_IFMT)
+        {
+            case S_IFBLK : os << "Block device";      break;
+            case S_IFCHR : os << "Character device";  break;
+            case S_IFDIR : os << "Directory";         break;
+            case S_IFIFO : os << "Named pipe / FIFO"; break;
+            case S_IFLNK : os << "Symbolic link";     break;
+            case S_IFREG : os << "Regular file";      break;
+            case S_IFSOCK: os << "Socket";            break;
+        }
+        os << '\n';
+    }
+    if(field("Access Permissions", STATX_MODE))
+    {
+        mode_t perms = fileinfo.stx_mode & (S_IRWXU | S_IRWXG | S_IRWXO);
+        os << file_type << utils::to_permissions(perms) << " (" << std::oct << perms << std::dec << ")\n";
     }
-    os << '\n';
-    mode_t perms = fileinfo.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO);
-    os << std::setw(spc_w) << "Access Permissions"       << " │ " << file_type
-       << utils::to_permissions(perms) << " (" << std::oct << perms << std::dec << ")\n";
 
-    auto [ f_sz  , f_sz_frc  , f_sz_u   ] = utils::to_human_readable_size(fileinfo.st_size);
-    os << std::setw(spc_w) << "File size"                << " │ " << f_sz  ;
-    if(f_sz_frc   > 0) { os << '.' << std::setw(2) << std::setfill('0') << f_sz_frc   << std::setfill(' '); }
-    os << ' ' << f_sz_u   << "B (" << fileinfo.st_size     << " B)\n";
+    if(field("File size", STATX_SIZE))
+    {
+        auto [ f_sz  , f_sz_frc  , f_sz_u   ] = utils::to_human_readable_size(fileinfo.stx_size);
+        os << f_sz  ;
+        if(f_sz_frc   > 0) { os << '.' << std::setw(2) << std::setfill('0') << f_sz_frc   << std::setfill(' '); }
+        os << ' ' << f_sz_u   << "B (" << fileinfo.stx_size     << " B)\n";
+    }
 
-    auto [ blk_sz, blk_sz_frc, blk_sz_u ] = utils::to_human_readable_size(fileinfo.st_blksize);
+    auto [ blk_sz, blk_sz_frc, blk_sz_u ] = utils::to_human_readable_size(fileinfo.stx_blksize);
     os << std::setw(spc_w) << "Preferred I/O block size" << " │ " << blk_sz;
     if(blk_sz_frc > 0) { os << '.' << std::setw(2) << std::setfill('0') << blk_sz_frc << std::setfill(' '); }
-    os << ' ' << blk_sz_u << "B (" << fileinfo.st_blksize  << " B)\n";
+    os << ' ' << blk_sz_u << "B (" << fileinfo.stx_blksize  << " B)\n";
 
-    os << std::setw(spc_w) << "# of blocks allocated"    << " │ "
-       << ( (fileinfo.st_blocks * 512) / fileinfo.st_blksize ) << " blks. / "
-       << fileinfo.st_blocks << " bu (1 bu = 512 B)\n";
+    if(field("# of blocks allocated", STATX_BLOCKS))
+        os << ( (fileinfo.stx_blocks * 512) / std::max<size_t>(fileinfo.stx_blksize, 1) ) << " blks. / "
+           << fileinfo.stx_blocks << " bu (1 bu = 512 B)\n";
 
-    os << std::setw(spc_w) << "Last file access"         << " │ "
-       << std::put_time(std::localtime(&fileinfo.st_atime), "%a, %b %e, %Y, at %H:%M:%S %Z") << '\n';
-    os << std::setw(spc_w) << "Last status change"       << " │ "
-       << std::put_time(std::localtime(&fileinfo.st_ctime), "%a, %b %e, %Y, at %H:%M:%S %Z") << '\n';
-    os << std::setw(spc_w) << "Last file modification"   << " │ "
-       << std::put_time(std::localtime(&fileinfo.st_mtime), "%a, %b %e, %Y, at %H:%M:%S %Z") << '\n';
+    if(field("Last file access", STATX_ATIME))       { print_time(os, fileinfo.stx_atime); os << '\n'; }
+    if(field("Last status change", STATX_CTIME))     { print_time(os, fileinfo.stx_ctime); os << '\n'; }
+    if(field("Last file modification", STATX_MTIME)) { print_time(os, fileinfo.stx_mtime); os << '\n'; }
+    if(field("File creation (birth)", STATX_BTIME))  { print_time(os, fileinfo.stx_btime); os << '\n'; }
 
     return os;
-}
\ No newline at end of file
+}
+
+size_t fsop::inspect_pipe_capacity(std::string_view path)
+{
+    // Non-blocking mode prevents open() from waiting for a writer.
+    auto resolved = resolve_path(path);
+    int descriptor = openat(resolved.directory(), resolved.name.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if(descriptor == -1 and refresh_path(resolved, path))
+        descriptor = openat(resolved.directory(), resolved.name.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if(descriptor == -1)
+        throw std::system_error
+        (
+            errno, std::generic_category(),
+            "inspect_pipe_capacity(): unable to open pipe for reading"
+        );
+
+    int capacity = fcntl(descriptor, F_GETPIPE_SZ);
+    int error = errno;
+    close(descriptor);
+
+    if(capacity == -1)
+        throw std::system_error
+        (
+            error, std::generic_category(),
+            "inspect_pipe_capacity(): failed to retrieve capacity (possibly not a pipe)"
+        );
+    return capacity;
+}
+
+std::ostream& fsop::print_pipe_info(std::ostream& os, size_t capacity)
+{
+    auto [ p_sz, p_sz_frc, p_sz_u ] = utils::to_human_readable_size(capacity);
+    os << std::setw(spc_w) << "Pipe capacity"            << " │ " << p_sz;
+    if(p_sz_frc   > 0) { os << '.' << std::setw(2) << std::setfill('0') << p_sz_frc   << std::setfill(' '); }
+    os << ' ' << p_sz_u   << "B (" << capacity             << " B)\n";
+    return os;
+}
+
+std::ostream& fsop::print_extent_info(std::ostream& os, const std::vector<Extent>& extents)
+{
+    size_t data_bytes = 0, hole_bytes = 0, data_extents = 0;
+    for(const auto& extent : extents)
+    {
+        if(extent.data) { data_bytes += extent.nbytes; ++data_extents; }
+        else hole_bytes += extent.nbytes;
+    }
+
+    auto [ d_sz, d_sz_frc, d_sz_u ] = utils::to_human_readable_size(data_bytes);
+    os << std::setw(spc_w) << "Data (non-hole) content"  << " │ " << d_sz;
+    if(d_sz_frc   > 0) { os << '.' << std::setw(2) << std::setfill('0') << d_sz_frc   << std::setfill(' '); }
+    os << ' ' << d_sz_u   << "B (" << data_bytes << " B) in " << data_extents << " extent(s)\n";
+
+    auto [ h_sz, h_sz_frc, h_sz_u ] = utils::to_human_readable_size(hole_bytes);
+    os << std::setw(spc_w) << "Holes"                    << " │ " << h_sz;
+    if(h_sz_frc   > 0) { os << '.' << std::setw(2) << std::setfill('0') << h_sz_frc   << std::setfill(' '); }
+    os << ' ' << h_sz_u   << "B (" << hole_bytes << " B) in "
+       << extents.size() - data_extents << " hole(s)\n";
+    return os;
+}
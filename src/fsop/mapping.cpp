@@ -0,0 +1,117 @@
+/**
+ * @file mapping.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the methods defined in fsop/mapping.hpp
+ * @version 1.0
+ * @date 2022-06-10
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/mapping.hpp"
+
+#include <cerrno>       // errno, errno macros
+
+#include <system_error> // std::system_error
+
+#include <unistd.h>     // lseek64
+#include <sys/mman.h>   // mmap, munmap
+
+fsop::MappedFile::MappedFile(File& file)
+{
+    auto inode_data = file.stat();
+    if((inode_data.st_mode & S_IFMT) != S_IFREG)
+    {
+        throw std::system_error
+        (
+            ENODEV, std::generic_category(),
+            "MappedFile(): memory mapping is supported only for regular files"
+        );
+    }
+
+    _offset = lseek64(file.descriptor(), 0, SEEK_CUR);
+    if(_offset == -1)
+        throw std::system_error(errno, std::generic_category(), "MappedFile(): failed to retrieve file offset");
+
+    _size = inode_data.st_size;
+    // Empty files cannot be mapped, and are represented by an empty region.
+    if(_size == 0) return;
+
+    void* region = mmap(nullptr, _size, PROT_READ, MAP_SHARED, file.descriptor(), 0);
+    if(region == MAP_FAILED)
+    {
+        std::string error_desc = "MappedFile(): ";
+        switch(errno)
+        {
+            case EACCES:
+                error_desc += "file is not open for reading";
+                break;
+            case ENOMEM:
+                error_desc += "out of address space or mapping limit reached";
+                break;
+            case ENODEV:
+                error_desc += "filesystem does not support memory mapping";
+                break;
+            default:
+                error_desc += "unknown, code " + std::to_string(errno);
+        }
+        _size = 0;
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+    _data = static_cast<const char*>(region);
+}
+
+fsop::MappedFile& fsop::MappedFile::operator=(MappedFile&& tmp_mapping) noexcept
+{
+    if(this != &tmp_mapping)
+    {
+        this->unmap();
+        _data   = tmp_mapping._data;
+        _size   = tmp_mapping._size;
+        _offset = tmp_mapping._offset;
+        tmp_mapping._data = nullptr;
+        tmp_mapping._size = 0;
+    }
+    return *this;
+}
+
+std::string_view fsop::MappedFile::read(size_t nbytes, off64_t offset, int whence)
+{
+    off64_t base = 0;
+    switch(whence)
+    {
+        case SEEK_SET: base = 0; break;
+        case SEEK_CUR: base = _offset; break;
+        case SEEK_END: base = _size; break;
+        default:
+            throw std::system_error(EINVAL, std::generic_category(), "read(): invalid offset base");
+    }
+    if(base + offset < 0)
+        throw std::system_error(EINVAL, std::generic_category(), "read(): offset before beginning of file");
+    _offset = base + offset;
+
+    size_t available = static_cast<size_t>(_offset) < _size ? _size - _offset : 0;
+    if(nbytes != File::bytes_till_end and available == 0)
+    {
+        throw std::system_error
+        (
+            0, std::generic_category(),
+            "read(): offset pointer at end of file (EOF)"
+        );
+    }
+    if(nbytes > available) nbytes = available;
+
+    std::string_view content { nbytes ? _data + _offset : "", nbytes };
+    _offset += nbytes;
+    return content;
+}
+
+void fsop::MappedFile::unmap() noexcept
+{
+    if(_data != nullptr)
+    {
+        munmap(const_cast<char*>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+}
@@ -9,29 +9,31 @@
  */
 
 #include "fsop/file.hpp"
+#include "fsop/directory.hpp" // fsop::resolve_path
 
 #include <cerrno>       // errno, errno macros
 
 #include <system_error> // std::system_error
 
-#include <fcntl.h>      // open
-#include <unistd.h>     // pipe
+#include <fcntl.h>      // openat, O_* constants
+#include <unistd.h>     // pipe, close
+#include <sys/stat.h>   // fstat64
 
 fsop::File fsop::File::open_file(std::string_view path, int open_options)
 {
-    // Check if file previously exists
-    struct stat64 inode_data;
-    int status = stat64(path.data(), &inode_data);
-    if(status == -1)
-    {
-         throw std::system_error
-         (
-              ENOENT, std::generic_category(),
-              "open_file(): failed to open file (possibly non-existent) '" +
-              std::string(path.data(), path.size()) + "'"
-         );
-    }
-    int fd = open(path.data(), open_options);
+    // Descriptors are not leaked into executed programs.
+    open_options |= O_CLOEXEC;
+
+    // Read-only opens skip access time updates where permitted (owner or CAP_FOWNER only).
+    bool no_atime = (open_options & O_ACCMODE) == O_RDONLY and not (open_options & (O_PATH | O_NOATIME));
+    // Only the leaf component is looked up, relative to a cached handle of the parent directory,
+    // which is revalidated if the lookup fails.
+    auto resolved = resolve_path(path);
+    int fd = openat(resolved.directory(), resolved.name.c_str(), open_options | (no_atime ? O_NOATIME : 0));
+    if(fd == -1 and refresh_path(resolved, path))
+        fd = openat(resolved.directory(), resolved.name.c_str(), open_options | (no_atime ? O_NOATIME : 0));
+    if(fd == -1 and no_atime and errno == EPERM)
+        fd = openat(resolved.directory(), resolved.name.c_str(), open_options);
     if(fd == -1)
     {
         std::string error_desc = "open_file(): ";
@@ -58,21 +60,44 @@ fsop::File fsop::File::open_file(std::string_view path, int open_options)
             case EINVAL:
                 error_desc += "invalid characters in filename";
                 break;
+            case EMFILE:
+                error_desc += "process limit for open file descriptors exhausted (FD table full)";
+                break;
             case ENFILE:
                 error_desc += "system quota for total open files exhausted";
                 break;
+            case ELOOP:
+                error_desc += "too many symbolic links encountered while resolving the path";
+                break;
+            case ENOTDIR:
+                error_desc += "a directory component in the path is not a directory";
+                break;
             case ENOENT:
-                error_desc += "non-existent directory components in path";
+                error_desc += "failed to open file (possibly non-existent) '" +
+                              std::string(path.data(), path.size()) + "'";
                 break;
             default:
                 error_desc += "unknown, code " + std::to_string(errno);
         }
         throw std::system_error(errno, std::generic_category(), error_desc.c_str());
     }
+    // Information is taken from the opened descriptor, hence describes the
+    // same inode the descriptor refers to even if the path is renamed meanwhile.
+    struct stat64 inode_data;
+    if(fstat64(fd, &inode_data) == -1)
+    {
+        auto error_code = errno;
+        ::close(fd);
+        throw std::system_error
+        (
+            error_code, std::generic_category(),
+            "open_file(): failed to stat opened file '" + std::string(path.data(), path.size()) + "'"
+        );
+    }
     return { fd, inode_data };
 }
 
-std::pair<fsop::File, fsop::File> fsop::File::create_unnamed_pipe()
+std::pair<fsop::File, fsop::File> fsop::File::create_unnamed_pipe(size_t capacity)
 {
     int pipefd[2];
     int status = pipe(pipefd);
@@ -99,5 +124,7 @@ std::pair<fsop::File, fsop::File> fsop::File::create_unnamed_pipe()
         ( errno, std::generic_category(), error_desc );
     }
 
-    return std::make_pair(File{ pipefd[0] }, File{ pipefd[1] });
+    auto pipe_ends = std::make_pair(File{ pipefd[0] }, File{ pipefd[1] });
+    if(capacity > 0) pipe_ends.first.set_pipe_capacity(capacity);
+    return pipe_ends;
 }
\ No newline at end of file
@@ -0,0 +1,232 @@
+/**
+ * @file parallel.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the functions defined in fsop/parallel.hpp
+ * @version 1.0
+ * @date 2022-06-17
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/parallel.hpp"
+
+#include <mutex>              // std::mutex, std::unique_lock
+#include <atomic>             // std::atomic
+#include <string>             // std::string
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+#include <algorithm>          // std::min
+#include <exception>          // std::exception_ptr, std::current_exception
+#include <system_error>       // std::system_error
+#include <condition_variable> // std::condition_variable
+
+namespace
+{
+    /**
+     * @brief A buffer holding a chunk read by a worker, until consumed.
+     */
+    struct Slot
+    {
+        /** Storage for the chunk. */
+        std::string data;
+        /** Number of valid bytes in the storage. */
+        size_t      size  = 0;
+        /** Whether the slot holds a chunk yet to be consumed. */
+        bool        ready = false;
+    };
+}
+
+size_t fsop::read_parallel(
+    File& file, const std::function<void(std::string_view)>& consumer,
+    off64_t offset, size_t nbytes, size_t chunk_size, unsigned workers
+)
+{
+    if(chunk_size == 0 or workers == 0)
+        throw std::system_error
+        (
+            EINVAL, std::generic_category(),
+            "read_parallel(): chunk size and worker count must be positive"
+        );
+    if(nbytes == 0) return 0;
+
+    const size_t chunk_count = (nbytes + chunk_size - 1) / chunk_size;
+    workers = static_cast<unsigned>(std::min<size_t>(workers, chunk_count));
+    const size_t window = 2 * size_t{ workers };
+
+    std::vector<Slot> slots(window);
+    std::mutex              lock;
+    std::condition_variable changed;
+    size_t                  next_chunk = 0, consumed = 0;
+    bool                    stopped = false;
+    std::exception_ptr      read_error;
+
+    auto work = [&] {
+        for(;;)
+        {
+            size_t index;
+            {
+                std::unique_lock guard { lock };
+                changed.wait(guard, [&] {
+                    return stopped or next_chunk >= chunk_count or next_chunk < consumed + window;
+                });
+                if(stopped or next_chunk >= chunk_count) return;
+                index = next_chunk++;
+            }
+
+            auto& slot = slots[index % window];
+            auto chunk_offset = static_cast<size_t>(index) * chunk_size;
+            auto length = std::min(chunk_size, nbytes - chunk_offset);
+            size_t size = 0;
+            try
+            {
+                slot.data.resize(length);
+                for(size_t nbytes_read = 1; size < length and nbytes_read > 0; size += nbytes_read)
+                    nbytes_read = file.pread(slot.data.data() + size, length - size, offset + chunk_offset + size);
+            }
+            catch(...)
+            {
+                std::unique_lock guard { lock };
+                if(not read_error) read_error = std::current_exception();
+                stopped = true;
+                changed.notify_all();
+                return;
+            }
+
+            {
+                std::unique_lock guard { lock };
+                slot.size = size; slot.ready = true;
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool; pool.reserve(workers);
+    auto stop_pool = [&] {
+        {
+            std::unique_lock guard { lock };
+            stopped = true;
+        }
+        changed.notify_all();
+        for(auto& worker : pool) worker.join();
+    };
+
+    size_t total = 0;
+    try
+    {
+        for(unsigned index = 0; index < workers; ++index)
+            pool.emplace_back(work);
+
+        for(size_t index = 0; index < chunk_count; ++index)
+        {
+            auto& slot = slots[index % window];
+            {
+                std::unique_lock guard { lock };
+                changed.wait(guard, [&] { return slot.ready or read_error; });
+                if(not slot.ready) break;
+            }
+
+            consumer(std::string_view{ slot.data.data(), slot.size });
+            total += slot.size;
+
+            // A short chunk marks the end of the file.
+            bool last = slot.size < std::min(chunk_size, nbytes - index * chunk_size);
+            {
+                std::unique_lock guard { lock };
+                slot.ready = false; ++consumed;
+            }
+            changed.notify_all();
+            if(last) break;
+        }
+    }
+    catch(...)
+    {
+        stop_pool();
+        throw;
+    }
+
+    stop_pool();
+    if(read_error) std::rethrow_exception(read_error);
+    return total;
+}
+
+size_t fsop::write_parallel(
+    File& source, off64_t source_offset, File& target, off64_t target_offset,
+    size_t nbytes, size_t chunk_size, unsigned workers, bool preallocate
+)
+{
+    if(chunk_size == 0 or workers == 0)
+        throw std::system_error
+        (
+            EINVAL, std::generic_category(),
+            "write_parallel(): chunk size and worker count must be positive"
+        );
+    if(nbytes == 0) return 0;
+
+    if(preallocate)
+    {
+        try
+        {
+            target.allocate(target_offset, nbytes);
+        }
+        catch(std::system_error& error)
+        {
+            // Preallocation is an optimization: proceed without it where unsupported.
+            if(error.code().value() != EOPNOTSUPP) throw;
+        }
+    }
+
+    const size_t chunk_count = (nbytes + chunk_size - 1) / chunk_size;
+    workers = static_cast<unsigned>(std::min<size_t>(workers, chunk_count));
+
+    std::atomic<size_t>  next_chunk { 0 }, total { 0 };
+    std::atomic<bool>    stopped    { false };
+    std::mutex           lock;
+    std::exception_ptr   copy_error;
+
+    auto work = [&] {
+        std::string buffer(std::min(chunk_size, nbytes), '\0');
+        try
+        {
+            for(size_t index; not stopped and (index = next_chunk++) < chunk_count; )
+            {
+                auto chunk_offset = index * chunk_size;
+                auto length = std::min(chunk_size, nbytes - chunk_offset);
+
+                size_t size = 0;
+                for(size_t nbytes_read = 1; size < length and nbytes_read > 0; size += nbytes_read)
+                    nbytes_read = source.pread(buffer.data() + size, length - size, source_offset + chunk_offset + size);
+
+                std::string_view content { buffer.data(), size };
+                for(auto position = target_offset + static_cast<off64_t>(chunk_offset); not content.empty(); )
+                {
+                    auto nbytes_written = target.pwrite(content, position);
+                    content.remove_prefix(nbytes_written); position += nbytes_written;
+                }
+                total += size;
+            }
+        }
+        catch(...)
+        {
+            std::unique_lock guard { lock };
+            if(not copy_error) copy_error = std::current_exception();
+            stopped = true;
+        }
+    };
+
+    std::vector<std::thread> pool; pool.reserve(workers);
+    try
+    {
+        for(unsigned index = 0; index < workers; ++index)
+            pool.emplace_back(work);
+    }
+    catch(...)
+    {
+        stopped = true;
+        for(auto& worker : pool) worker.join();
+        throw;
+    }
+    for(auto& worker : pool) worker.join();
+
+    if(copy_error) std::rethrow_exception(copy_error);
+    return total;
+}
@@ -0,0 +1,307 @@
+/**
+ * @file uring.cpp
+ * @author Kinshuk Vasisht (kinshuk.mcs21@cs.du.ac.in, RN: 19)
+ * @brief Source file implementing the methods defined in fsop/uring.hpp
+ * @version 1.0
+ * @date 2022-06-14
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#include "fsop/uring.hpp"
+
+#include <cerrno>       // errno, errno macros
+#include <cstring>      // std::memset
+
+#include <deque>        // std::deque
+#include <string>       // std::string
+#include <algorithm>    // std::min, std::max
+#include <system_error> // std::system_error
+
+#include <unistd.h>     // close, syscall
+#include <sys/mman.h>   // mmap, munmap
+
+#if __has_include(<linux/io_uring.h>)
+    #include <sys/syscall.h>    // __NR_io_uring_*
+    #include <linux/io_uring.h> // struct io_uring_*, IORING_* constants
+    #define FSOP_HAS_IO_URING 1
+#else
+    #define FSOP_HAS_IO_URING 0
+#endif
+
+#if FSOP_HAS_IO_URING
+
+struct fsop::IORing::Rings
+{
+    /** Mapped submission ring and its size. */
+    void* sq_ring = MAP_FAILED; size_t sq_ring_size = 0;
+    /** Mapped completion ring and its size (may alias the submission ring). */
+    void* cq_ring = MAP_FAILED; size_t cq_ring_size = 0;
+    /** Mapped submission queue entries and their size. */
+    struct io_uring_sqe* sqes = static_cast<struct io_uring_sqe*>(MAP_FAILED); size_t sqes_size = 0;
+
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array, sq_entries;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe* cqes;
+
+    /** Tail of the submission ring as seen locally, including prepared requests. */
+    unsigned sq_local_tail = 0;
+    /** Number of prepared but unsubmitted requests. */
+    unsigned sq_pending = 0;
+
+    ~Rings()
+    {
+        if(sqes != MAP_FAILED) munmap(sqes, sqes_size);
+        if(cq_ring != MAP_FAILED and cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+        if(sq_ring != MAP_FAILED) munmap(sq_ring, sq_ring_size);
+    }
+};
+
+fsop::IORing::IORing(unsigned queue_depth) : _rings(std::make_unique<Rings>())
+{
+    struct io_uring_params params; std::memset(&params, 0, sizeof(params));
+    _descriptor = syscall(__NR_io_uring_setup, std::max(queue_depth, 1U), &params);
+    if(_descriptor == -1)
+    {
+        std::string error_desc = "IORing(): ";
+        switch(errno)
+        {
+            case ENOSYS:
+                error_desc += "io_uring is not supported by the running kernel";
+                break;
+            case EPERM:
+                error_desc += "io_uring is disabled for the process";
+                break;
+            case EINVAL:
+                error_desc += "queue depth exceeds the limit of the running kernel";
+                break;
+            case EMFILE:
+            case ENFILE:
+                error_desc += "system or process quota for open files exhausted";
+                break;
+            case ENOMEM:
+                error_desc += "out of kernel memory or locked memory limit reached";
+                break;
+            default:
+                error_desc += "unknown, code " + std::to_string(errno);
+        }
+        _descriptor = File::invalid_descriptor;
+        throw std::system_error(errno, std::generic_category(), error_desc);
+    }
+
+    auto& rings = *_rings;
+    rings.sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    rings.cq_ring_size = params.cq_off.cqes  + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mapping = params.features & IORING_FEAT_SINGLE_MMAP;
+    if(single_mapping)
+        rings.sq_ring_size = rings.cq_ring_size = std::max(rings.sq_ring_size, rings.cq_ring_size);
+
+    auto map_region = [this](size_t size, off_t offset) {
+        return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _descriptor, offset);
+    };
+    rings.sq_ring = map_region(rings.sq_ring_size, IORING_OFF_SQ_RING);
+    if(rings.sq_ring != MAP_FAILED)
+        rings.cq_ring = single_mapping ? rings.sq_ring : map_region(rings.cq_ring_size, IORING_OFF_CQ_RING);
+    if(rings.cq_ring != MAP_FAILED)
+    {
+        rings.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        rings.sqes = static_cast<struct io_uring_sqe*>(map_region(rings.sqes_size, IORING_OFF_SQES));
+    }
+    if(rings.sqes == MAP_FAILED)
+    {
+        int error_code = errno;
+        _rings.reset(); ::close(_descriptor);
+        _descriptor = File::invalid_descriptor;
+        throw std::system_error(error_code, std::generic_category(), "IORing(): failed to map io_uring queues");
+    }
+
+    auto sq_base = static_cast<char*>(rings.sq_ring), cq_base = static_cast<char*>(rings.cq_ring);
+    rings.sq_head    = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+    rings.sq_tail    = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+    rings.sq_mask    = reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+    rings.sq_array   = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+    rings.sq_entries = params.sq_entries;
+    rings.cq_head    = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+    rings.cq_tail    = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+    rings.cq_mask    = reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+    rings.cqes       = reinterpret_cast<struct io_uring_cqe*>(cq_base + params.cq_off.cqes);
+    rings.sq_local_tail = *rings.sq_tail;
+}
+
+fsop::IORing::~IORing()
+{
+    _rings.reset();
+    if(_descriptor != File::invalid_descriptor)
+        ::close(_descriptor);
+}
+
+bool fsop::IORing::prepare_read(int descriptor, char* buffer, unsigned nbytes, off64_t offset, std::uint64_t tag) noexcept
+{
+    auto& rings = *_rings;
+    unsigned head = __atomic_load_n(rings.sq_head, __ATOMIC_ACQUIRE);
+    if(rings.sq_local_tail - head >= rings.sq_entries) return false;
+
+    unsigned index = rings.sq_local_tail & *rings.sq_mask;
+    auto& entry = rings.sqes[index];
+    std::memset(&entry, 0, sizeof(entry));
+    entry.opcode    = IORING_OP_READ;
+    entry.fd        = descriptor;
+    entry.addr      = reinterpret_cast<std::uint64_t>(buffer);
+    entry.len       = nbytes;
+    entry.off       = offset;
+    entry.user_data = tag;
+    rings.sq_array[index] = index;
+
+    ++rings.sq_local_tail; ++rings.sq_pending;
+    // Publish the entry to the kernel.
+    __atomic_store_n(rings.sq_tail, rings.sq_local_tail, __ATOMIC_RELEASE);
+    return true;
+}
+
+unsigned fsop::IORing::submit(unsigned min_complete)
+{
+    auto& rings = *_rings;
+    unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    long status;
+    while((status = syscall(__NR_io_uring_enter, _descriptor, rings.sq_pending, min_complete, flags, nullptr, 0)) == -1)
+    {
+        if(errno != EINTR)
+            throw std::system_error(errno, std::generic_category(), "submit(): failed to submit io_uring requests");
+    }
+    rings.sq_pending -= std::min<unsigned>(rings.sq_pending, status);
+    return status;
+}
+
+bool fsop::IORing::next_completion(std::uint64_t& tag, int& result) noexcept
+{
+    auto& rings = *_rings;
+    unsigned head = *rings.cq_head;
+    if(head == __atomic_load_n(rings.cq_tail, __ATOMIC_ACQUIRE)) return false;
+
+    const auto& entry = rings.cqes[head & *rings.cq_mask];
+    tag = entry.user_data; result = entry.res;
+    // Release the entry back to the kernel.
+    __atomic_store_n(rings.cq_head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+unsigned fsop::IORing::queue_depth() const noexcept
+{
+    return _rings->sq_entries;
+}
+
+#else
+
+struct fsop::IORing::Rings {};
+
+fsop::IORing::IORing([[maybe_unused]] unsigned queue_depth)
+{
+    throw std::system_error(ENOSYS, std::generic_category(), "IORing(): io_uring is not supported by the build");
+}
+fsop::IORing::~IORing() = default;
+
+bool fsop::IORing::prepare_read(int, char*, unsigned, off64_t, std::uint64_t) noexcept { return false; }
+unsigned fsop::IORing::submit(unsigned) { return 0; }
+bool fsop::IORing::next_completion(std::uint64_t&, int&) noexcept { return false; }
+unsigned fsop::IORing::queue_depth() const noexcept { return 0; }
+
+#endif
+
+size_t fsop::read_batches_async(
+    File& file, const std::vector<Batch>& batches, unsigned queue_depth,
+    const std::function<void(size_t, std::string_view)>& on_ready
+)
+{
+    // Largest single request, as lengths of requests are limited to 32 bits.
+    static constexpr size_t max_request = 1ULL << 30;
+
+    IORing ring { queue_depth };
+
+    std::vector<std::string> buffers(batches.size());
+    std::vector<size_t> nbytes_read(batches.size(), 0);
+    std::vector<bool> complete(batches.size(), false);
+    // Batches whose reads were cut short and need to be resumed.
+    std::deque<size_t> resumptions;
+
+    size_t next_submission = 0, next_delivery = 0, ncalls = 0;
+    unsigned inflight = 0, depth = ring.queue_depth();
+
+    auto prepare = [&](size_t index) {
+        const auto& batch = batches[index];
+        size_t remaining = batch.nbytes - nbytes_read[index];
+        return ring.prepare_read(
+            file.descriptor(), buffers[index].data() + nbytes_read[index],
+            static_cast<unsigned>(std::min(remaining, max_request)),
+            batch.offset + nbytes_read[index], index
+        );
+    };
+
+    // First failure reported by a completion. Reads in flight are drained before reporting it,
+    // as the kernel may still be writing into the buffers.
+    int error_code = 0;
+    // Whether any read succeeded, to tell an unsupported opcode apart from failing reads.
+    bool any_read = false;
+
+    while(inflight > 0 or (error_code == 0 and next_delivery < batches.size()))
+    {
+        // Fill the queue: resumed batches first, then fresh batches in order.
+        while(error_code == 0 and inflight < depth and not resumptions.empty() and prepare(resumptions.front()))
+        {
+            resumptions.pop_front(); ++inflight;
+        }
+        // Batches in flight or complete but undelivered are bounded by the queue depth, so that
+        // a slow batch does not let completed batches behind it accumulate without bound.
+        while(error_code == 0 and inflight < depth and next_submission < batches.size()
+              and next_submission < next_delivery + depth)
+        {
+            if(batches[next_submission].nbytes == 0)
+            {
+                complete[next_submission++] = true;
+                continue;
+            }
+            buffers[next_submission].resize(batches[next_submission].nbytes);
+            if(not prepare(next_submission)) break;
+            ++next_submission; ++inflight;
+        }
+
+        if(inflight > 0)
+        {
+            ring.submit(1); ++ncalls;
+        }
+
+        std::uint64_t tag; int result;
+        while(ring.next_completion(tag, result))
+        {
+            --inflight;
+            if(result < 0)
+            {
+                if(error_code == 0) error_code = -result;
+                continue;
+            }
+            any_read = true;
+            nbytes_read[tag] += result;
+            if(result > 0 and nbytes_read[tag] < batches[tag].nbytes)
+                resumptions.push_back(tag);
+            else
+                complete[tag] = true;
+        }
+
+        // Deliver completed batches in order, releasing their buffers.
+        while(error_code == 0 and next_delivery < batches.size() and complete[next_delivery])
+        {
+            on_ready(next_delivery, { buffers[next_delivery].data(), nbytes_read[next_delivery] });
+            std::string().swap(buffers[next_delivery]);
+            ++next_delivery;
+        }
+    }
+
+    // Kernels before 5.6 reject IORING_OP_READ itself with EINVAL on every request.
+    if(error_code == EINVAL and not any_read and next_delivery == 0)
+        throw std::system_error(
+            EOPNOTSUPP, std::generic_category(),
+            "read_batches_async(): io_uring reads (IORING_OP_READ) are not supported by the running kernel"
+        );
+    if(error_code != 0)
+        throw std::system_error(error_code, std::generic_category(), "read_batches_async(): failed to read file content");
+    return ncalls;
+}
@@ -8,6 +8,7 @@
  * @copyright Copyright (c) 2022
  */
 
+#include "fsop/directory.hpp" // fsop::clear_directory_cache
 #include "fsop/utilities.hpp"
 
 #include <cstring>      // strlen
@@ -179,4 +180,6 @@ void fsop::utils::change_directory(std::string_view path)
             errno, std::generic_category(),
             "change_directory(): failed to change current working directory"
         );
+    // Cached handles of relative parent directories now refer to the wrong directories.
+    fsop::clear_directory_cache();
 }
\ No newline at end of file
@@ -13,7 +13,9 @@
 
 #include <iostream>           // std::cout, std::cerr
 
-#include "fsop/create.hpp"    // fsop::create_file, fsop::create_pipe
+#include "fsop/file.hpp"      // fsop::File
+#include "fsop/create.hpp"    // fsop::create_file, fsop::create_pipe, fsop::Allocation
+#include "fsop/extents.hpp"   // fsop::count_extents
 #include "fsop/utilities.hpp" // fsop::utils::to_permissions
 
 int fsop_cli::create(const argparse::types::result_map& args, std::string_view program_name)
@@ -23,6 +25,12 @@ int fsop_cli::create(const argparse::types::result_map& args, std::string_view p
     auto type      = std::any_cast<std::string>(args.at("type")     );
     auto overwrite = std::any_cast<bool>       (args.at("overwrite"));
     auto quiet     = std::any_cast<bool>       (args.at("quiet")    );
+    auto size      = std::any_cast<size_t>     (args.at("size")     );
+    auto allocation_name = std::any_cast<std::string>(args.at("allocation"));
+
+    auto allocation = fsop::Allocation::preallocate;
+    if(allocation_name == "sparse")    allocation = fsop::Allocation::sparse;
+    else if(allocation_name == "zero") allocation = fsop::Allocation::zero;
 
     auto type_name = (type == "regular" ? "regular file" : "named pipe");
 
@@ -34,13 +42,33 @@ int fsop_cli::create(const argparse::types::result_map& args, std::string_view p
                       << fsop::utils::to_permissions(perms) << "' ...\n";
 
         if(type == "regular")
-            fsop::create_file(path, perms, overwrite);
+            fsop::create_file(path, perms, overwrite, size, allocation);
         else
+        {
+            if(size > 0)
+                std::cerr << program_name << ": warning: pipes have no size, so --size will have no effect\n";
             fsop::create_pipe(path, perms, overwrite);
+        }
 
         if(not quiet)
             std::cout << program_name << ": successfully created "
-                      << type_name << " '" << path << "'.\n\n";
+                      << type_name << " '" << path << "'.\n";
+
+        if(not quiet and type == "regular" and size > 0)
+        {
+            std::cout << program_name << ": allocated " << size << " bytes (" << allocation_name << ")";
+            try
+            {
+                auto file = fsop::File::open_file(path, O_RDONLY);
+                std::cout << ", spanning " << fsop::count_extents(file) << " extent(s)\n";
+            }
+            catch(std::system_error& error)
+            {
+                std::cout << "\n";
+                std::cerr << program_name << ": warning: unable to count extents: " << error.what() << "\n";
+            }
+        }
+        if(not quiet) std::cout << "\n";
         return EXIT_SUCCESS;
     }
     catch(std::system_error& error)
@@ -11,32 +11,193 @@
 
 #include "fsop_cli.hpp"     // Base header containing function declaration for 'inspect'
 
-#include <iostream>         // std::cout, std::cerr
+#include <mutex>              // std::mutex, std::unique_lock
+#include <thread>             // std::thread
+#include <sstream>            // std::ostringstream
+#include <iostream>           // std::cout, std::cerr
+#include <algorithm>          // std::min
+#include <condition_variable> // std::condition_variable
 
-#include "fsop/inspect.hpp" // fsop::inspect_file, fsop::print_stat_info
+#include "fsop/file.hpp"    // fsop::File
+#include "fsop/inspect.hpp" // fsop::inspect_file, fsop::print_stat_info, fsop::inspect_pipe_capacity
+#include "fsop/extents.hpp" // fsop::map_extents
 
-int fsop_cli::inspect(const argparse::types::result_map& args, std::string_view program_name)
+namespace
 {
-    auto paths            = std::any_cast<std::vector<std::string>>(args.at("path"));
-    auto quiet            = std::any_cast<bool>                    (args.at("quiet"));
-    auto follow_symlinks  = std::any_cast<bool>                    (args.at("follow-symlinks"));
+    /**
+     * @brief Output produced by inspecting a path, held until it can be printed in order.
+     */
+    struct Report
+    {
+        /** Content for STDOUT. */
+        std::string output;
+        /** Warnings and errors for STDERR. */
+        std::string errors;
+        /** Whether the report is complete and yet to be printed. */
+        bool        ready = false;
+    };
 
-    for(const auto& path : paths)
+    /**
+     * @brief Inspects a path and renders the information to display into a report.
+     *
+     * @param path Path to inspect.
+     * @param program_name Name of the program, for messages.
+     * @param quiet Whether progress messages are suppressed.
+     * @param follow_symlinks Whether symbolic links are resolved.
+     * @param fields Mask of STATX_* fields to display.
+     * @param dont_sync Whether locally cached attributes are accepted.
+     * @param map_holes Whether the data and holes of regular files are mapped.
+     * @param report Report to render output into.
+     */
+    void inspect_path(
+        const std::string& path, std::string_view program_name, bool quiet,
+        bool follow_symlinks, unsigned int fields, bool dont_sync, bool map_holes, Report& report
+    )
     {
+        std::ostringstream output, errors;
         try
         {
             if(not quiet)
-                std::cout << program_name << ": trying to inspect '" << path << "' ... ";
-            auto information = fsop::inspect_file(path, follow_symlinks);
+                output << program_name << ": trying to inspect '" << path << "' ... ";
+            // The file type is always requested, to select further information to display.
+            auto information = fsop::inspect_file(path, follow_symlinks, fields | STATX_TYPE, dont_sync);
             if(not quiet)
-                std::cout << "done\n";
-            fsop::print_stat_info(std::cout, information) << '\n';
+                output << "done\n";
+            fsop::print_stat_info(output, information, fields);
+
+            auto mode = fsop::file_mode(information);
+            if(S_ISFIFO(mode))
+            {
+                try
+                {
+                    fsop::print_pipe_info(output, fsop::inspect_pipe_capacity(path));
+                }
+                catch(std::system_error& error)
+                {
+                    errors << program_name << ": warning: " << error.what() << "\n";
+                }
+            }
+            // Mapping data and holes opens the file, hence it is only done on request.
+            else if(S_ISREG(mode) and map_holes)
+            {
+                try
+                {
+                    auto file = fsop::File::open_file(path, O_RDONLY);
+                    fsop::print_extent_info(output, fsop::map_extents(file));
+                }
+                catch(std::system_error& error)
+                {
+                    errors << program_name << ": warning: " << error.what() << "\n";
+                }
+            }
+            output << '\n';
         }
         catch(std::system_error& error)
         {
-            if(not quiet) std::cout << "error\n";
-            std::cerr << program_name << ": error: " << error.what() << "\n\n";
+            if(not quiet) output << "error\n";
+            errors << program_name << ": error: " << error.what() << "\n\n";
+        }
+        report.output = output.str();
+        report.errors = errors.str();
+    }
+
+    /**
+     * @brief Prints a report, flushing STDOUT first so that output and errors interleave in order.
+     *
+     * @param report Report to print.
+     */
+    void print_report(const Report& report)
+    {
+        std::cout << report.output;
+        if(not report.errors.empty())
+        {
+            std::cout.flush();
+            std::cerr << report.errors;
+        }
+    }
+}
+
+int fsop_cli::inspect(const argparse::types::result_map& args, std::string_view program_name)
+{
+    auto paths            = std::any_cast<std::vector<std::string>>(args.at("path"));
+    auto quiet            = std::any_cast<bool>                    (args.at("quiet"));
+    auto follow_symlinks  = std::any_cast<bool>                    (args.at("follow-symlinks"));
+    auto fields           = std::any_cast<unsigned int>            (args.at("fields"));
+    auto dont_sync        = std::any_cast<bool>                    (args.at("cached"));
+    auto workers          = std::any_cast<unsigned>                (args.at("workers"));
+    auto map_holes        = std::any_cast<bool>                    (args.at("extents"));
+
+    if(map_holes and dont_sync)
+    {
+        std::cerr << program_name << ": warning: mapping extents reads from the filesystem, "
+                  << "so --extents will have no effect with --cached\n\n";
+        map_holes = false;
+    }
+
+    workers = static_cast<unsigned>(std::min<size_t>(std::max(workers, 1U), paths.size()));
+    if(workers <= 1)
+    {
+        for(const auto& path : paths)
+        {
+            Report report;
+            inspect_path(path, program_name, quiet, follow_symlinks, fields, dont_sync, map_holes, report);
+            print_report(report);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Workers inspect paths concurrently, running ahead of the printer by at most
+    // two paths each, while reports are printed in the order of the paths.
+    const size_t window = 2 * size_t{ workers };
+    std::vector<Report>     reports(window);
+    std::mutex              lock;
+    std::condition_variable changed;
+    size_t                  next_path = 0, printed = 0;
+
+    auto work = [&] {
+        for(;;)
+        {
+            size_t index;
+            {
+                std::unique_lock guard { lock };
+                changed.wait(guard, [&] {
+                    return next_path >= paths.size() or next_path < printed + window;
+                });
+                if(next_path >= paths.size()) return;
+                index = next_path++;
+            }
+
+            Report report;
+            inspect_path(paths[index], program_name, quiet, follow_symlinks, fields, dont_sync, map_holes, report);
+            {
+                std::unique_lock guard { lock };
+                reports[index % window] = std::move(report);
+                reports[index % window].ready = true;
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool; pool.reserve(workers);
+    for(unsigned index = 0; index < workers; ++index)
+        pool.emplace_back(work);
+
+    for(size_t index = 0; index < paths.size(); ++index)
+    {
+        auto& report = reports[index % window];
+        {
+            std::unique_lock guard { lock };
+            changed.wait(guard, [&] { return report.ready; });
         }
+
+        print_report(report);
+        {
+            std::unique_lock guard { lock };
+            report.ready = false; ++printed;
+        }
+        changed.notify_all();
     }
+
+    for(auto& worker : pool) worker.join();
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
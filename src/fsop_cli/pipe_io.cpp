@@ -13,21 +13,73 @@
 
 #include <cstring>          // std::strerror
 
+#include <chrono>           // std::chrono::steady_clock
 #include <iostream>         // std::cout, std::cerr
 
 #include <unistd.h>         // fork, getpid
 #include <sys/types.h>      // pid_t
 
 #include "fsop/file.hpp"    // fsop::File::create_unnamed_pipe
+#include "fsop/buffered_file.hpp" // fsop::BufferedFile
+#include "fsop/utilities.hpp" // fsop::utils::to_human_readable_size
+
+namespace
+{
+    /** Number of bytes requested per in-kernel transfer in splice mode. */
+    constexpr size_t splice_chunk_size = 1ULL << 20;
+
+    /**
+     * @brief Transfers all content from a file to another within the kernel, until EOF.
+     *
+     * @param source File to transfer content from.
+     * @param target File to transfer content to.
+     * @param chunk_size Number of bytes to request per transfer.
+     * @return {size_t} Total number of bytes transferred.
+     */
+    size_t transfer_all(fsop::File& source, fsop::File& target, size_t chunk_size)
+    {
+        size_t total = 0, nbytes;
+        while((nbytes = source.send_to(target, chunk_size)) > 0) total += nbytes;
+        return total;
+    }
+
+    /**
+     * @brief Reports the throughput of a transfer to STDERR.
+     *
+     * @param program_name Name of the CLI program.
+     * @param role Role of the reporting process (Parent or Child).
+     * @param pid Process ID of the reporting process.
+     * @param verb Action performed (e.g., "moved").
+     * @param nbytes Number of bytes transferred.
+     * @param seconds Duration of the transfer, in seconds.
+     */
+    void report_throughput(std::string_view program_name, std::string_view role, pid_t pid,
+                           std::string_view verb, size_t nbytes, double seconds)
+    {
+        auto rate = static_cast<size_t>(seconds > 0 ? nbytes / seconds : 0);
+        auto [ size, fraction, unit ] = fsop::utils::to_human_readable_size(rate);
+        std::cerr << program_name << ": [" << role << ", PID " << std::setw(5) << pid << "] "
+                  << verb << ' ' << nbytes << " bytes in " << seconds << " s (" << size;
+        if(fraction > 0) std::cerr << '.' << std::setw(2) << std::setfill('0') << fraction << std::setfill(' ');
+        std::cerr << ' ' << unit << "B/s)\n";
+    }
+}
 
 int fsop_cli::pipe_io(const argparse::types::result_map& args, std::string_view program_name)
 {
     auto quiet     = std::any_cast<bool>       (args.at("quiet")    );
+    auto use_splice = std::any_cast<bool>      (args.at("splice")   );
+    auto pipe_size = std::any_cast<size_t>     (args.at("pipe-size"));
+    auto buffer_size = std::any_cast<size_t>   (args.at("buffer-size"));
 
     if(not quiet)
         std::cout << program_name << ": initializing I/O over unnamed pipe ... \n";
 
-    auto [ reader, writer ] = fsop::File::create_unnamed_pipe();
+    auto [ reader, writer ] = fsop::File::create_unnamed_pipe(pipe_size);
+
+    if(not quiet and pipe_size > 0)
+        std::cout << program_name << ": pipe capacity set to "
+                  << reader.pipe_capacity() << " bytes\n";
 
     std::string buffer;
 
@@ -47,6 +99,28 @@ int fsop_cli::pipe_io(const argparse::types::result_map& args, std::string_view
         std::cerr << "\n\n";
         return EXIT_FAILURE;
     }
+    else if(status == 0 and use_splice)
+    {
+        reader.close(); // Explicitly close reader end.
+
+        if(not quiet)
+            std::cout << program_name << ": [Child , PID " << std::setw(5)
+                      << pid << "] writer ready, moving STDIN into the pipe ...\n" << std::flush;
+
+        try
+        {
+            fsop::File standard_input { STDIN_FILENO };
+            auto start = std::chrono::steady_clock::now();
+            auto nbytes = transfer_all(standard_input, writer, splice_chunk_size);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            writer.close();
+            report_throughput(program_name, "Child ", pid, "moved", nbytes, elapsed.count());
+        }
+        catch(std::system_error& error)
+        {
+            std::cerr << program_name << ": error: " << error.what() << "\n";
+        }
+    }
     else if(status == 0)
     {
         reader.close(); // Explicitly close reader end.
@@ -56,25 +130,71 @@ int fsop_cli::pipe_io(const argparse::types::result_map& args, std::string_view
                       << pid << "] writer ready. Enter data to STDIN, "
                       << "send <EOF> (^D) to exit ...\n";
 
-        while(getline(std::cin, buffer))
+        try
         {
-            try
-            {
-                auto nbytes_written = writer.write(buffer);
-                if(not quiet)
+            fsop::File standard_input { STDIN_FILENO };
+            fsop::BufferedFile buffered_writer { writer, buffer_size };
+
+            // Lines are coalesced in the buffered writer, and handed over to the pipe
+            // once no more input is immediately available (or the buffer fills up).
+            auto hand_over = [&] {
+                auto nbytes_written = buffered_writer.flush();
+                if(not quiet and nbytes_written > 0)
                     std::cout << program_name << ": [Child , PID "
                               << std::setw(5) << pid << "] wrote "
                               << nbytes_written << " bytes\n";
-            }
-            catch(std::system_error& error)
+            };
+
+            std::string line; buffer.resize(buffer_size);
+            size_t nbytes_read;
+            while((nbytes_read = standard_input.read(buffer.data(), buffer.size())) > 0)
             {
-                std::cerr << program_name << ": error: " << error.what() << "\n";
+                std::string_view input { buffer.data(), nbytes_read };
+                for(auto end = input.find('\n'); end != input.npos; end = input.find('\n'))
+                {
+                    line.append(input.substr(0, end + 1));
+                    buffered_writer.write(line);
+                    line.clear(); input.remove_prefix(end + 1);
+                }
+                line.append(input);
+                hand_over();
             }
+            // Terminate the last line, as done for the others.
+            if(not line.empty())
+                buffered_writer.write(line + '\n');
+            hand_over();
+        }
+        catch(std::system_error& error)
+        {
+            std::cerr << program_name << ": error: " << error.what() << "\n";
         }
 
         if(not quiet)
+        {
+            std::cout << program_name << ": [Child , PID " << std::setw(5)
+                      << pid << "] write statistics: ";
+            fsop::print_write_stats(std::cout, writer.write_stats()) << '\n';
             std::cout << program_name << ": [Child , PID " << std::setw(5)
                       << pid << "] write complete, exiting ...\n";
+        }
+    }
+    else if(use_splice)
+    {
+        writer.close(); // Explicitly close writer end.
+
+        try
+        {
+            fsop::File standard_output { STDOUT_FILENO };
+            std::cout.flush();
+            auto start = std::chrono::steady_clock::now();
+            auto nbytes = transfer_all(reader, standard_output, splice_chunk_size);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            report_throughput(program_name, "Parent", pid, "moved", nbytes, elapsed.count());
+        }
+        catch(std::system_error& error)
+        {
+            std::cerr << program_name << ": error: " << error.what() << "\n";
+        }
     }
     else
     {
@@ -88,7 +208,7 @@ int fsop_cli::pipe_io(const argparse::types::result_map& args, std::string_view
                     std::cout << program_name << ": [Parent, PID "
                               << std::setw(5) << pid << "] read "
                               << buffer.size() << " bytes\n";
-                std::cout << buffer << "\n";
+                std::cout << buffer;
             }
             catch(std::system_error& error)
             {
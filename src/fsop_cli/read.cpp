@@ -11,12 +11,350 @@
 
 #include "fsop_cli.hpp"         // Base header containing function declaration for 'read'
 
+#include <sstream>              // std::ostringstream
 #include <iostream>             // std::cout, std::cerr
-#include <algorithm>            // std::max
+#include <optional>             // std::optional
+#include <algorithm>            // std::max, std::clamp
+
+#include <unistd.h>             // STDOUT_FILENO
+#include <fcntl.h>              // POSIX_FADV_DONTNEED
 
 #include "fsop/file.hpp"        // fsop::File
+#include "fsop/batch.hpp"       // fsop::Batch, fsop::read_batches, fsop::write_vectored
+#include "fsop/uring.hpp"       // fsop::IORing, fsop::read_batches_async
+#include "fsop/mapping.hpp"     // fsop::MappedFile
+#include "fsop/extents.hpp"     // fsop::map_extents, fsop::read_sparse
+#include "fsop/parallel.hpp"    // fsop::read_parallel
+#include "fsop/direct.hpp"      // fsop::AlignedBufferPool, fsop::read_direct
+#include "fsop/advice.hpp"      // fsop::advise_access, fsop::drop_cached
 #include "fsop/utilities.hpp"   // fsop::utils::to_type
 
+namespace
+{
+    /**
+     * @brief Describes a read batch, as specified through the arguments.
+     */
+    struct ReadBatch
+    {
+        /** Byte offset to begin reading content from. */
+        off64_t offset;
+        /** Offset base for movement reference along the file. */
+        int     offset_base;
+        /** Number of bytes to read, or fsop::File::bytes_till_end. */
+        size_t  byte_count;
+    };
+
+    /**
+     * @brief Writes the informational header describing a read batch to a given output stream.
+     *
+     * @param os The output stream to write content to.
+     * @param program_name Name of the CLI program.
+     * @param batch_index Index of the batch (1-based).
+     * @param batch The batch to describe.
+     */
+    void describe_batch(std::ostream& os, std::string_view program_name, size_t batch_index, const ReadBatch& batch)
+    {
+        os << program_name << ": read batch #" << batch_index << ": read ";
+        if(batch.byte_count == fsop::File::bytes_till_end)
+            os << "all bytes till the end ";
+        else
+            os << batch.byte_count << " bytes ";
+        os << "from offset " << batch.offset << " relative to the ";
+        switch(batch.offset_base)
+        {
+            case SEEK_SET: os << "beginning\n"; break;
+            case SEEK_CUR: os << "current position\n"; break;
+            case SEEK_END: os << "end\n"; break;
+        }
+    }
+
+    /**
+     * @brief Resolves byte counts of batches over absolute offsets to finite values,
+     *  by limiting reads till the end to the size of the file.
+     *
+     * @param file Regular file to resolve batches for.
+     * @param batches Batches to resolve, with offsets relative to the beginning.
+     * @return {std::vector<fsop::Batch>} Batches with finite byte counts.
+     */
+    std::vector<fsop::Batch> resolve_batches(fsop::File& file, const std::vector<ReadBatch>& batches)
+    {
+        auto file_size = static_cast<off64_t>(file.stat().st_size);
+
+        std::vector<fsop::Batch> ranges; ranges.reserve(batches.size());
+        for(const auto& batch : batches)
+        {
+            size_t byte_count = batch.byte_count;
+            if(byte_count == fsop::File::bytes_till_end)
+                byte_count = batch.offset < file_size ? file_size - batch.offset : 0;
+            ranges.push_back({ batch.offset, byte_count });
+        }
+        return ranges;
+    }
+
+    /**
+     * @brief Plans the byte ranges covered by batches, by following the movement of the
+     *  file offset across batches from its current position, as the reads would.
+     *
+     * @param file Regular file to plan batches for.
+     * @param batches Batches to plan.
+     * @return {std::vector<fsop::Batch>} Ranges covered by the batches, relative to the beginning.
+     */
+    std::vector<fsop::Batch> plan_batches(fsop::File& file, const std::vector<ReadBatch>& batches)
+    {
+        auto file_size = static_cast<off64_t>(file.stat().st_size);
+        auto position  = lseek64(file.descriptor(), 0, SEEK_CUR);
+
+        std::vector<fsop::Batch> ranges; ranges.reserve(batches.size());
+        for(const auto& batch : batches)
+        {
+            off64_t base = batch.offset_base == SEEK_SET ? 0
+                         : batch.offset_base == SEEK_CUR ? position : file_size;
+            auto begin = std::clamp<off64_t>(base + batch.offset, 0, file_size);
+            auto nbytes = std::min<size_t>(batch.byte_count, file_size - begin);
+            ranges.push_back({ begin, nbytes });
+            position = begin + nbytes;
+        }
+        return ranges;
+    }
+
+    /**
+     * @brief Executes read batches over absolute offsets via vectored reads, and
+     *  emits the content of all batches to STDOUT via vectored writes.
+     *
+     * @param file Regular file to read content from.
+     * @param batches Batches to execute, with offsets relative to the beginning.
+     * @param quiet Whether to suppress informational messages.
+     * @param program_name Name of the CLI program.
+     */
+    void read_vectored(fsop::File& file, const std::vector<ReadBatch>& batches, bool quiet, std::string_view program_name)
+    {
+        std::vector<std::string> contents;
+        auto nreads = fsop::read_batches(file, resolve_batches(file, batches), contents);
+
+        // Informational text surrounding each batch, kept alive until the output is written.
+        std::vector<std::string> headers, trailers;
+        std::vector<std::string_view> output;
+        if(not quiet)
+        {
+            headers.reserve(batches.size()); trailers.reserve(batches.size());
+            output.reserve(3 * batches.size());
+        }
+        else output.reserve(batches.size());
+
+        for(size_t index = 0; index < batches.size(); ++index)
+        {
+            const auto& content = contents[index];
+            if(not quiet)
+            {
+                std::ostringstream header; describe_batch(header, program_name, index + 1, batches[index]);
+                headers.push_back(header.str());
+                trailers.push_back(content.empty() ? "<empty-file, no content>\n\n" : "\n\n");
+                output.push_back(headers.back());
+                if(not content.empty()) output.push_back(content);
+                output.push_back(trailers.back());
+
+                if(batches[index].byte_count != fsop::File::bytes_till_end and content.size() < batches[index].byte_count)
+                    std::cerr << program_name << ": read batch #" << index + 1 << ": (read only "
+                              << content.size() << " bytes from the file)\n";
+            }
+            else output.push_back(content);
+        }
+
+        fsop::File standard_output { STDOUT_FILENO };
+        std::cout.flush();
+        fsop::write_vectored(standard_output, output);
+
+        if(not quiet)
+            std::cout << program_name << ": read " << batches.size() << " batch(es) using "
+                      << nreads << " vectored read(s)\n\n";
+    }
+
+    /**
+     * @brief Executes read batches over absolute offsets asynchronously via io_uring,
+     *  and emits the content of the batches to STDOUT in batch order.
+     *
+     * @param file Regular file to read content from.
+     * @param batches Batches to execute, with offsets relative to the beginning.
+     * @param queue_depth Maximum number of reads in flight.
+     * @param quiet Whether to suppress informational messages.
+     * @param program_name Name of the CLI program.
+     * @return {bool} false if io_uring cannot be used for reading (setup failed or reads are
+     *  unsupported) before any content was emitted, true otherwise.
+     */
+    bool read_async(fsop::File& file, const std::vector<ReadBatch>& batches, unsigned queue_depth,
+                    bool quiet, std::string_view program_name)
+    {
+        size_t ndelivered = 0, nsubmissions = 0;
+        try
+        {
+            nsubmissions = fsop::read_batches_async(
+                file, resolve_batches(file, batches), queue_depth,
+                [&](size_t index, std::string_view content) {
+                    ++ndelivered;
+                    const auto& batch = batches[index];
+                    if(not quiet)
+                        describe_batch(std::cout, program_name, index + 1, batch);
+                    if(not quiet and content.empty()) std::cout << "<empty-file, no content>";
+                    else std::cout << content;
+                    if(not quiet and batch.byte_count != fsop::File::bytes_till_end and content.size() < batch.byte_count)
+                        std::cerr << "(read only " << content.size() << " bytes from the file)\n";
+                    if(not quiet)
+                        std::cout << "\n\n";
+                }
+            );
+        }
+        catch(std::system_error& error)
+        {
+            // Errors setting up the ring (such as a queue depth beyond the kernel limit) or
+            // an unsupported opcode leave nothing emitted, so that reads can be retried.
+            switch(error.code().value())
+            {
+                case ENOSYS: case EPERM: case EINVAL: case ENOMEM: case EOPNOTSUPP:
+                    if(ndelivered == 0)
+                    {
+                        if(not quiet)
+                            std::cerr << program_name << ": warning: " << error.what() << "\n";
+                        return false;
+                    }
+            }
+            throw;
+        }
+
+        if(not quiet)
+            std::cout << program_name << ": read " << batches.size() << " batch(es) using "
+                      << nsubmissions << " io_uring submission(s) with a queue depth of "
+                      << queue_depth << "\n\n";
+        return true;
+    }
+
+    /**
+     * @brief Executes read batches over absolute offsets by walking data extents, either
+     *  emitting content to STDOUT with holes synthesized as zeros, or reporting the map
+     *  of data extents and holes of each batch.
+     *
+     * @param file Regular file to read content from.
+     * @param batches Batches to execute, with offsets relative to the beginning.
+     * @param chunk_size Largest number of bytes emitted at once.
+     * @param map_only Whether to report the extent map instead of the content.
+     * @param quiet Whether to suppress informational messages.
+     * @param program_name Name of the CLI program.
+     */
+    void read_extents(fsop::File& file, const std::vector<ReadBatch>& batches, size_t chunk_size,
+                      bool map_only, bool quiet, std::string_view program_name)
+    {
+        auto ranges = resolve_batches(file, batches);
+        for(size_t index = 0; index < batches.size(); ++index)
+        {
+            const auto& batch = batches[index];
+            if(not quiet)
+                describe_batch(std::cout, program_name, index + 1, batch);
+
+            if(map_only)
+            {
+                size_t data_bytes = 0, hole_bytes = 0;
+                for(const auto& extent : fsop::map_extents(file, ranges[index].offset, ranges[index].nbytes))
+                {
+                    std::cout << (extent.data ? "data " : "hole ") << std::setw(20) << extent.offset
+                              << ' ' << std::setw(20) << extent.offset + static_cast<off64_t>(extent.nbytes)
+                              << ' ' << std::setw(20) << extent.nbytes << '\n';
+                    (extent.data ? data_bytes : hole_bytes) += extent.nbytes;
+                }
+                if(not quiet)
+                    std::cout << program_name << ": " << data_bytes << " bytes of data, "
+                              << hole_bytes << " bytes of holes\n\n";
+                continue;
+            }
+
+            auto nbytes_read = fsop::read_sparse(
+                file,
+                [](std::string_view chunk) { std::cout.write(chunk.data(), chunk.size()); },
+                chunk_size, ranges[index].offset, ranges[index].nbytes
+            );
+            if(not quiet and nbytes_read == 0) std::cout << "<empty-file, no content>";
+            if(not quiet and batch.byte_count != fsop::File::bytes_till_end and nbytes_read < batch.byte_count)
+                std::cerr << "(read only " << nbytes_read << " bytes from the file)\n";
+            if(not quiet)
+                std::cout << "\n\n";
+        }
+    }
+
+    /**
+     * @brief Executes read batches over absolute offsets by reading chunks of each batch
+     *  in parallel from a pool of workers, and emits the content to STDOUT in order.
+     *
+     * @param file Regular file to read content from.
+     * @param batches Batches to execute, with offsets relative to the beginning.
+     * @param workers Number of worker threads to read with.
+     * @param chunk_size Number of bytes read per positional read.
+     * @param quiet Whether to suppress informational messages.
+     * @param program_name Name of the CLI program.
+     */
+    void read_with_workers(fsop::File& file, const std::vector<ReadBatch>& batches, unsigned workers,
+                           size_t chunk_size, bool quiet, std::string_view program_name)
+    {
+        auto ranges = resolve_batches(file, batches);
+        for(size_t index = 0; index < batches.size(); ++index)
+        {
+            const auto& batch = batches[index];
+            if(not quiet)
+                describe_batch(std::cout, program_name, index + 1, batch);
+
+            auto nbytes_read = fsop::read_parallel(
+                file,
+                [](std::string_view chunk) { std::cout.write(chunk.data(), chunk.size()); },
+                ranges[index].offset, ranges[index].nbytes, chunk_size, workers
+            );
+            if(not quiet and nbytes_read == 0) std::cout << "<empty-file, no content>";
+            if(not quiet and batch.byte_count != fsop::File::bytes_till_end and nbytes_read < batch.byte_count)
+                std::cerr << "(read only " << nbytes_read << " bytes from the file)\n";
+            if(not quiet)
+                std::cout << "\n\n";
+        }
+    }
+
+    /**
+     * @brief Executes read batches over absolute offsets via direct I/O through aligned
+     *  buffers, and emits the content to STDOUT in order.
+     *
+     * @param file Regular file (opened with O_DIRECT) to read content from.
+     * @param batches Batches to execute, with offsets relative to the beginning.
+     * @param chunk_size Number of bytes read per call, rounded up to the block size.
+     * @param quiet Whether to suppress informational messages.
+     * @param program_name Name of the CLI program.
+     */
+    void read_with_direct_io(fsop::File& file, const std::vector<ReadBatch>& batches,
+                             size_t chunk_size, bool quiet, std::string_view program_name)
+    {
+        auto alignment = fsop::direct_alignment(file);
+        fsop::AlignedBufferPool pool {
+            std::max(chunk_size, alignment.offset), std::max(alignment.memory, alignment.offset), 1
+        };
+        if(not quiet)
+            std::cout << program_name << ": direct I/O with " << alignment.offset << " B blocks, "
+                      << alignment.memory << " B buffer alignment and " << pool.buffer_size()
+                      << " B buffers\n\n";
+
+        auto ranges = resolve_batches(file, batches);
+        for(size_t index = 0; index < batches.size(); ++index)
+        {
+            const auto& batch = batches[index];
+            if(not quiet)
+                describe_batch(std::cout, program_name, index + 1, batch);
+
+            auto nbytes_read = fsop::read_direct(
+                file, pool, alignment,
+                [](std::string_view chunk) { std::cout.write(chunk.data(), chunk.size()); },
+                ranges[index].offset, ranges[index].nbytes
+            );
+            if(not quiet and nbytes_read == 0) std::cout << "<empty-file, no content>";
+            if(not quiet and batch.byte_count != fsop::File::bytes_till_end and nbytes_read < batch.byte_count)
+                std::cerr << "(read only " << nbytes_read << " bytes from the file)\n";
+            if(not quiet)
+                std::cout << "\n\n";
+        }
+    }
+}
+
 int fsop_cli::read(const argparse::types::result_map& args, std::string_view program_name)
 {
     try
@@ -24,6 +362,21 @@ int fsop_cli::read(const argparse::types::result_map& args, std::string_view pro
         auto path    = std::any_cast<std::string>(args.at("path") );
         auto as_pipe = std::any_cast<bool>       (args.at("pipe") );
         auto quiet   = std::any_cast<bool>       (args.at("quiet"));
+        auto use_mmap = std::any_cast<bool>      (args.at("mmap") );
+        auto absolute = std::any_cast<bool>      (args.at("absolute"));
+        auto vectored = std::any_cast<bool>      (args.at("vectored"));
+        auto uring    = std::any_cast<bool>      (args.at("uring"));
+        auto stream   = std::any_cast<bool>      (args.at("stream"));
+        auto sparse   = std::any_cast<bool>      (args.at("sparse"));
+        auto extent_map = std::any_cast<bool>    (args.at("extent-map"));
+        auto workers  = std::any_cast<unsigned>  (args.at("workers"));
+        bool parallel = workers > 1;
+        auto direct   = std::any_cast<bool>      (args.at("direct"));
+        auto advise   = std::any_cast<bool>      (args.at("advise"));
+        auto drop_cache = std::any_cast<bool>    (args.at("drop-cache"));
+
+        // Vectored, asynchronous, extent-aware, parallel and direct reads are positional, and hence need absolute offsets.
+        if(vectored or uring or sparse or extent_map or parallel or direct) absolute = true;
 
         if(path.empty())
         {
@@ -40,7 +393,7 @@ int fsop_cli::read(const argparse::types::result_map& args, std::string_view pro
         }
         else // Read from a regular file or named pipe.
         {
-            auto file = fsop::File::open_file(path, O_RDONLY);
+            auto file = fsop::File::open_file(path, O_RDONLY | (direct ? O_DIRECT : 0));
             auto file_type = file.stat().st_mode & S_IFMT;
             auto type_name = fsop::utils::to_type(file_type);
 
@@ -51,6 +404,27 @@ int fsop_cli::read(const argparse::types::result_map& args, std::string_view pro
                           << "  (to auto-detect file type, avoid using the '--pipe' flag)\n\n";
                 return EXIT_FAILURE;
             }
+            else if(file_type != S_IFREG and use_mmap)
+            {
+                std::cerr << program_name << ": error: '" << path << "' is not a regular file\n"
+                          << std::setw(program_name.size()) << ' '
+                          << "  (memory mapping via '--mmap' is supported only for regular files)\n\n";
+                return EXIT_FAILURE;
+            }
+            else if(int(use_mmap) + int(vectored) + int(uring) + int(stream) + int(sparse)
+                    + int(extent_map) + int(parallel) + int(direct) > 1)
+            {
+                std::cerr << program_name << ": error: only one of '--mmap', '--vectored', '--uring', '--stream', "
+                          << "'--sparse', '--extent-map', '--workers' (> 1) and '--direct' can be used at a time\n\n";
+                return EXIT_FAILURE;
+            }
+            else if(file_type != S_IFREG and absolute)
+            {
+                std::cerr << program_name << ": error: '" << path << "' is not a regular file\n"
+                          << std::setw(program_name.size()) << ' '
+                          << "  (absolute offsets via '--absolute' are supported only for regular files)\n\n";
+                return EXIT_FAILURE;
+            }
             else if(file_type == S_IFREG or file_type == S_IFIFO)
             {
                 auto offsets      = std::any_cast<std::vector<off64_t>>(args.at("offset"));
@@ -67,41 +441,239 @@ int fsop_cli::read(const argparse::types::result_map& args, std::string_view pro
                     offset_bases.push_back(SEEK_CUR);
                     byte_counts .push_back(fsop::File::bytes_till_end);
                 }
+                else if(absolute and not offset_bases.empty())
+                {
+                    std::cerr << program_name << ": warning: --absolute flag is set, so values with "
+                              << "--offset-base will have no effect\n\n";
+                }
 
-                if(not quiet)
-                    std::cout << program_name << ": reading content from " << type_name
-                                << " '" << path << "' ...\n\n";
-
+                std::vector<ReadBatch> batches; batches.reserve(batch_counts);
                 for(size_t batch_index = 1; batch_index <= batch_counts; ++ batch_index)
                 {
                     auto offset      = offsets.size()      >= batch_index
                         ? offsets[batch_index-1]      : 0;
                     auto offset_base = offset_bases.size() >= batch_index
                         ? offset_bases[batch_index-1] : SEEK_CUR;
+                    if(absolute) offset_base = SEEK_SET;
                     auto byte_count  = byte_counts.size()  >= batch_index
                         ? byte_counts[batch_index-1]  : fsop::File::bytes_till_end;
+                    batches.push_back({ offset, offset_base, byte_count });
+                }
 
+                auto pipe_size = std::any_cast<size_t>(args.at("pipe-size"));
+                if(pipe_size > 0 and file_type == S_IFIFO)
+                {
+                    auto capacity = file.set_pipe_capacity(pipe_size);
                     if(not quiet)
+                        std::cout << program_name << ": pipe capacity set to " << capacity << " bytes\n";
+                }
+                else if(pipe_size > 0)
+                {
+                    std::cerr << program_name << ": warning: '" << path << "' is not a named pipe, "
+                              << "so --pipe-size will have no effect\n\n";
+                }
+
+                if(not quiet)
+                    std::cout << program_name << ": reading content from " << type_name
+                                << " '" << path << "' ...\n\n";
+
+                // Ranges covered by the batches, for passing access hints to the kernel.
+                std::vector<fsop::Batch> ranges;
+                if((advise or drop_cache) and file_type != S_IFREG)
+                    std::cerr << program_name << ": warning: '" << path << "' is not a regular file, "
+                              << "so --advise and --drop-cache will have no effect\n\n";
+                else if(advise or drop_cache)
+                    ranges = plan_batches(file, batches);
+
+                if(advise and not ranges.empty())
+                {
+                    try
                     {
-                        std::cout << program_name << ": read batch #" << batch_index
-                                    << ": read ";
-                        if(byte_count == fsop::File::bytes_till_end)
-                            std::cout << "all bytes till the end ";
-                        else
-                            std::cout << byte_count << " bytes ";
-                        std::cout << "from offset " << offset
-                                    << " relative to the ";
-                        switch(offset_base)
-                        {
-                            case SEEK_SET: std::cout << "beginning\n"; break;
-                            case SEEK_CUR: std::cout << "current position\n"; break;
-                            case SEEK_END: std::cout << "end\n"; break;
-                        }
+                        auto pattern = fsop::advise_access(file, ranges);
+                        if(not quiet)
+                            std::cout << program_name << ": advised a "
+                                      << (pattern == fsop::AccessPattern::sequential ? "sequential" : "random")
+                                      << " access pattern to the kernel\n\n";
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": warning: " << error.what() << "\n\n";
                     }
+                }
 
+                // Drops pages read from the page cache, once the batches are done.
+                auto finish = [&] {
+                    if(not drop_cache or ranges.empty()) return EXIT_SUCCESS;
                     try
                     {
-                        auto content = file.read(byte_count, offset, offset_base);
+                        fsop::drop_cached(file, ranges);
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": warning: " << error.what() << "\n\n";
+                    }
+                    return EXIT_SUCCESS;
+                };
+
+                if(vectored)
+                {
+                    try
+                    {
+                        read_vectored(file, batches, quiet, program_name);
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": read failure: " << error.what() << "\n\n";
+                    }
+                    return finish();
+                }
+                else if(sparse or extent_map)
+                {
+                    try
+                    {
+                        read_extents(file, batches, std::any_cast<size_t>(args.at("chunk-size")),
+                                     extent_map, quiet, program_name);
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": read failure: " << error.what() << "\n\n";
+                    }
+                    return finish();
+                }
+                else if(direct)
+                {
+                    try
+                    {
+                        read_with_direct_io(file, batches, std::any_cast<size_t>(args.at("chunk-size")),
+                                            quiet, program_name);
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": read failure: " << error.what() << "\n\n";
+                    }
+                    return finish();
+                }
+                else if(parallel)
+                {
+                    try
+                    {
+                        read_with_workers(file, batches, workers, std::any_cast<size_t>(args.at("chunk-size")),
+                                          quiet, program_name);
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": read failure: " << error.what() << "\n\n";
+                    }
+                    return finish();
+                }
+                else if(uring)
+                {
+                    auto queue_depth = std::any_cast<unsigned>(args.at("queue-depth"));
+                    try
+                    {
+                        if(read_async(file, batches, queue_depth, quiet, program_name))
+                            return finish();
+                        if(not quiet)
+                            std::cerr << program_name << ": warning: io_uring is unavailable, "
+                                      << "falling back to synchronous reads\n\n";
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": read failure: " << error.what() << "\n\n";
+                        return finish();
+                    }
+                }
+
+                auto chunk_size = std::any_cast<size_t>(args.at("chunk-size"));
+
+                // Buffer reused across batches, to avoid an allocation per batch.
+                std::string buffer;
+                // Mapping of the file, serving batches without copies when requested.
+                std::optional<fsop::MappedFile> mapping;
+                if(use_mmap) mapping.emplace(file);
+
+                // When STDOUT is a pipe, socket or regular file, content is transferred to it
+                // within the kernel (sendfile/splice), bypassing copies through user space.
+                fsop::File standard_output { STDOUT_FILENO };
+                auto output_type = standard_output.stat().st_mode & S_IFMT;
+                bool zero_copy = not mapping and
+                    (output_type == S_IFIFO or output_type == S_IFSOCK or output_type == S_IFREG);
+
+                // Drops pages of a batch from the page cache, once the batch has been read.
+                auto drop_batch = [&](size_t batch_index) {
+                    if(not drop_cache or ranges.empty()) return;
+                    try
+                    {
+                        fsop::drop_cached(file, { ranges[batch_index-1] });
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": warning: " << error.what() << "\n\n";
+                    }
+                };
+
+                for(size_t batch_index = 1; batch_index <= batches.size(); ++ batch_index)
+                {
+                    auto [ offset, offset_base, byte_count ] = batches[batch_index-1];
+
+                    if(not quiet)
+                        describe_batch(std::cout, program_name, batch_index, batches[batch_index-1]);
+
+                    try
+                    {
+                        if(stream)
+                        {
+                            // Streamed content is dropped from the page cache behind the reader.
+                            size_t nbytes_streamed = 0;
+                            auto nbytes_read = file.stream(
+                                [&](std::string_view chunk) {
+                                    std::cout.write(chunk.data(), chunk.size());
+                                    std::cout.flush();
+                                    if(drop_cache and not ranges.empty())
+                                        file.advise(ranges[batch_index-1].offset + nbytes_streamed,
+                                                    chunk.size(), POSIX_FADV_DONTNEED);
+                                    nbytes_streamed += chunk.size();
+                                },
+                                chunk_size, byte_count, offset, offset_base
+                            );
+                            if(not quiet and nbytes_read == 0) std::cout << "<empty-file, no content>";
+                            if(not quiet and byte_count != fsop::File::bytes_till_end and nbytes_read < byte_count)
+                                std::cerr << "(read only " << nbytes_read << " bytes from the file)\n";
+                            if(not quiet)
+                                std::cout << "\n\n";
+                            drop_batch(batch_index);
+                            continue;
+                        }
+
+                        if(zero_copy)
+                        {
+                            std::cout.flush();
+                            auto nbytes_sent = absolute
+                                ? file.psend_to(standard_output, byte_count, offset)
+                                : file.send_to (standard_output, byte_count, offset, offset_base);
+                            if(nbytes_sent == 0 and byte_count != fsop::File::bytes_till_end)
+                                std::cerr << program_name << ": read failure: read(): offset pointer at end of file (EOF)";
+                            else if(not quiet and nbytes_sent == 0) std::cout << "<empty-file, no content>";
+                            else if(not quiet and byte_count != fsop::File::bytes_till_end and nbytes_sent < byte_count)
+                                std::cerr << "(read only " << nbytes_sent << " bytes from the file)\n";
+                            if(not quiet)
+                                std::cout << "\n\n";
+                            drop_batch(batch_index);
+                            continue;
+                        }
+
+                        std::string_view content;
+                        if(mapping) content = mapping->read(byte_count, offset, offset_base);
+                        else if(absolute)
+                        {
+                            file.pread(buffer, byte_count, offset);
+                            content = buffer;
+                        }
+                        else
+                        {
+                            file.read(buffer, byte_count, offset, offset_base);
+                            content = buffer;
+                        }
                         if(not quiet and content.empty()) std::cout << "<empty-file, no content>";
                         else std::cout << content;
                         if(not quiet and byte_count != fsop::File::bytes_till_end and content.size() < byte_count)
@@ -114,6 +686,7 @@ int fsop_cli::read(const argparse::types::result_map& args, std::string_view pro
 
                     if(not quiet)
                         std::cout << "\n\n";
+                    drop_batch(batch_index);
                 }
             }
             else
@@ -11,13 +11,22 @@
 
 #include "fsop_cli.hpp"         // Base header containing function declaration for 'write'
 
+#include <chrono>               // std::chrono::milliseconds
 #include <iostream>             // std::cout, std::cerr
 #include <iterator>             // std::istreambuf_iterator
+#include <optional>             // std::optional
 #include <algorithm>            // std::max
 
 #include <signal.h>             // signal, SIG* constants
+#include <unistd.h>             // STDIN_FILENO
 
 #include "fsop/file.hpp"        // fsop::File
+#include "fsop/batch.hpp"       // fsop::Batch, fsop::write_batches
+#include "fsop/advice.hpp"      // fsop::drop_cached
+#include "fsop/ingest.hpp"      // fsop::ingest
+#include "fsop/buffered_file.hpp" // fsop::BufferedFile
+#include "fsop/parallel.hpp"    // fsop::write_parallel
+#include "fsop/direct.hpp"      // fsop::AlignedBufferPool, fsop::write_direct
 #include "fsop/utilities.hpp"   // fsop::utils::to_type
 
 int fsop_cli::write(const argparse::types::result_map& args, std::string_view program_name)
@@ -31,6 +40,17 @@ int fsop_cli::write(const argparse::types::result_map& args, std::string_view pr
         auto as_pipe = std::any_cast<bool>       (args.at("pipe") );
         auto quiet   = std::any_cast<bool>       (args.at("quiet"));
         auto lbuf    = std::any_cast<bool>       (args.at("line-buffered"));
+        auto absolute = std::any_cast<bool>      (args.at("absolute"));
+        auto vectored = std::any_cast<bool>      (args.at("vectored"));
+        auto stream   = std::any_cast<bool>      (args.at("stream"));
+        auto source_path = std::any_cast<std::string>(args.at("source"));
+        auto workers  = std::any_cast<unsigned>  (args.at("workers"));
+        bool parallel = workers > 1 or not source_path.empty();
+        auto direct   = std::any_cast<bool>      (args.at("direct"));
+        auto drop_cache = std::any_cast<bool>    (args.at("drop-cache"));
+
+        // Vectored, parallel and direct writes are positional, and hence need absolute offsets.
+        if(vectored or parallel or direct) absolute = true;
 
         if(path.empty())
         {
@@ -49,13 +69,23 @@ int fsop_cli::write(const argparse::types::result_map& args, std::string_view pr
         {
             bool append_mode = std::any_cast<bool>(args.at("append"));
 
-            int open_options = O_WRONLY;
+            // Direct writes read back partially covered blocks, and hence also need read access.
+            int open_options = direct ? O_RDWR | O_DIRECT : O_WRONLY;
             if(append_mode)
                 open_options |= O_APPEND;
             if(std::any_cast<bool>(args.at("truncate")))
                 open_options |= O_TRUNC;
 
             auto file = fsop::File::open_file(path, open_options);
+
+            auto durability = std::any_cast<std::string>(args.at("durability"));
+            if(durability != "none")
+                file.set_durability(
+                    durability == "batch" ? fsop::Durability::batch : fsop::Durability::periodic,
+                    std::any_cast<size_t>(args.at("sync-bytes")),
+                    std::any_cast<std::chrono::milliseconds>(args.at("sync-interval"))
+                );
+
             auto file_type = file.stat().st_mode & S_IFMT;
             auto type_name = fsop::utils::to_type(file_type);
 
@@ -66,6 +96,31 @@ int fsop_cli::write(const argparse::types::result_map& args, std::string_view pr
                           << "  (to auto-detect file type, avoid using the '--pipe' flag)\n\n";
                 return EXIT_FAILURE;
             }
+            else if(stream and (lbuf or vectored))
+            {
+                std::cerr << program_name << ": error: '--stream' cannot be combined with "
+                          << "'--line-buffered' or '--vectored'\n\n";
+                return EXIT_FAILURE;
+            }
+            else if(parallel and (stream or lbuf or vectored or append_mode))
+            {
+                std::cerr << program_name << ": error: parallel writes (via '--source' or '--workers') cannot be "
+                          << "combined with '--stream', '--line-buffered', '--vectored' or '--append'\n\n";
+                return EXIT_FAILURE;
+            }
+            else if(direct and (lbuf or vectored or parallel or append_mode))
+            {
+                std::cerr << program_name << ": error: '--direct' cannot be combined with '--line-buffered', "
+                          << "'--vectored', parallel writes (via '--source' or '--workers') or '--append'\n\n";
+                return EXIT_FAILURE;
+            }
+            else if(file_type != S_IFREG and absolute)
+            {
+                std::cerr << program_name << ": error: '" << path << "' is not a regular file\n"
+                          << std::setw(program_name.size()) << ' '
+                          << "  (absolute offsets via '--absolute' are supported only for regular files)\n\n";
+                return EXIT_FAILURE;
+            }
             else if(file_type == S_IFREG or file_type == S_IFIFO)
             {
                 auto offsets      = std::any_cast<std::vector<off64_t>>(args.at("offset"));
@@ -84,17 +139,141 @@ int fsop_cli::write(const argparse::types::result_map& args, std::string_view pr
                     std::cerr << program_name << ": warning: --append flag is set, so values with --offset and "
                               << "--offset-base will have no effect\n\n";
                 }
+                else if(absolute and not offset_bases.empty())
+                {
+                    std::cerr << program_name << ": warning: --absolute flag is set, so values with "
+                              << "--offset-base will have no effect\n\n";
+                }
+
+                auto pipe_size = std::any_cast<size_t>(args.at("pipe-size"));
+                if(pipe_size > 0 and file_type == S_IFIFO)
+                {
+                    auto capacity = file.set_pipe_capacity(pipe_size);
+                    if(not quiet)
+                        std::cout << program_name << ": pipe capacity set to " << capacity << " bytes\n";
+                }
+                else if(pipe_size > 0)
+                {
+                    std::cerr << program_name << ": warning: '" << path << "' is not a named pipe, "
+                              << "so --pipe-size will have no effect\n\n";
+                }
 
                 if(not quiet)
                     std::cout << program_name << ": writing content to " << type_name
                                 << " '" << path << "' ...\n\n";
 
+                if(drop_cache and file_type != S_IFREG)
+                    std::cerr << program_name << ": warning: '" << path << "' is not a regular file, "
+                              << "so --drop-cache will have no effect\n\n";
+
+                // Ranges of the file written by batches, to drop from the page cache.
+                std::vector<fsop::Batch> written_ranges;
+                // Records the range written by a batch: absolute writes begin at their offset, while relative
+                // writes end at the current offset of the file, past content still pending in a buffer.
+                auto note_written = [&](bool relative, off64_t offset, size_t nbytes, size_t npending = 0) {
+                    if(not drop_cache or file_type != S_IFREG or nbytes == 0) return;
+                    if(relative)
+                        offset = lseek64(file.descriptor(), 0, SEEK_CUR)
+                            + static_cast<off64_t>(npending) - static_cast<off64_t>(nbytes);
+                    written_ranges.push_back({ offset, nbytes });
+                };
+                // Drops written pages from the page cache, once they are on disk.
+                auto drop_written = [&] {
+                    if(not drop_cache or file_type != S_IFREG) return;
+                    try
+                    {
+                        file.sync_data();
+                        fsop::drop_cached(file, written_ranges);
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": warning: " << error.what() << "\n\n";
+                    }
+                };
+
+                if(parallel)
+                {
+                    if(batch_counts > 1)
+                        std::cerr << program_name << ": warning: the complete input is written by "
+                                  << "batch #1, so remaining batches will have no effect\n\n";
+
+                    // Content is read from the source file, or STDIN when it is a regular file.
+                    auto source = source_path.empty()
+                        ? fsop::File{ STDIN_FILENO }
+                        : fsop::File::open_file(source_path, O_RDONLY);
+                    if(S_ISREG(source.stat().st_mode))
+                    {
+                        try
+                        {
+                            auto source_offset = source_path.empty() ? lseek64(STDIN_FILENO, 0, SEEK_CUR) : 0;
+                            auto source_size = static_cast<off64_t>(source.stat().st_size);
+                            auto nbytes = source_offset < source_size ? source_size - source_offset : 0;
+
+                            auto target_offset = offsets.empty() ? 0 : offsets[0];
+                            auto nbytes_written = fsop::write_parallel(
+                                source, source_offset, file, target_offset, nbytes,
+                                std::any_cast<size_t>(args.at("chunk-size")), workers,
+                                std::any_cast<bool>(args.at("preallocate"))
+                            );
+                            note_written(false, target_offset, nbytes_written);
+                            // The copy is synced as a whole once every range is written, as durability requires.
+                            file.settle();
+                            if(not quiet)
+                                std::cout << program_name << ": wrote " << nbytes_written << " of "
+                                          << nbytes << " bytes to the file using " << workers << " worker(s)"
+                                          << (durability != "none" ? ", and synced the file" : "") << "\n\n";
+                        }
+                        catch(std::system_error& error)
+                        {
+                            std::cerr << program_name << ": write failure: " << error.what() << "\n\n";
+                        }
+                        drop_written();
+                        return EXIT_SUCCESS;
+                    }
+                    else if(not source_path.empty())
+                    {
+                        std::cerr << program_name << ": error: '" << source_path << "' is not a regular file\n"
+                                  << std::setw(program_name.size()) << ' '
+                                  << "  (parallel writes need an input of known size)\n\n";
+                        return EXIT_FAILURE;
+                    }
+                    std::cerr << program_name << ": warning: size of STDIN is unknown, "
+                              << "falling back to serial writes\n\n";
+                }
+
+                // Line-buffered batches continuing from the current offset are coalesced.
+                std::optional<fsop::BufferedFile> buffered;
+                if(lbuf and not absolute)
+                    buffered.emplace(file, std::any_cast<size_t>(args.at("buffer-size")));
+
+                // Aligned buffers and alignment requirements of the file, for direct writes.
+                std::optional<fsop::AlignedBufferPool> direct_pool;
+                fsop::DirectAlignment alignment { 0, 0 };
+                if(direct)
+                {
+                    alignment = fsop::direct_alignment(file);
+                    direct_pool.emplace(
+                        std::max(std::any_cast<size_t>(args.at("chunk-size")), alignment.offset),
+                        std::max(alignment.memory, alignment.offset), 1
+                    );
+                }
+                auto write_at = [&](std::string_view content, off64_t position) {
+                    return direct_pool
+                        ? fsop::write_direct(file, *direct_pool, alignment, content, position)
+                        : file.pwrite_all(content, position);
+                };
+
+                // Content and offsets of batches, deferred for a combined vectored write.
+                std::vector<std::string> pending_contents;
+                std::vector<off64_t>     pending_offsets;
+
                 for(size_t batch_index = 1; batch_index <= batch_counts; ++ batch_index)
                 {
                     auto offset      = offsets.size()      >= batch_index
                         ? offsets[batch_index-1]      : 0;
                     auto offset_base = offset_bases.size() >= batch_index
                         ? offset_bases[batch_index-1] : SEEK_CUR;
+                    if(absolute) offset_base = SEEK_SET;
 
                     if(not quiet)
                     {
@@ -119,6 +298,39 @@ int fsop_cli::write(const argparse::types::result_map& args, std::string_view pr
                             std::cout << "send <EOF> (^D) to finish ...\n";
                     }
 
+                    if(stream)
+                    {
+                        try
+                        {
+                            auto chunk_size = std::any_cast<size_t>(args.at("chunk-size"));
+                            fsop::File standard_input { STDIN_FILENO };
+
+                            // Only the first write seeks, the rest continue from where it ended.
+                            off64_t seek_offset = offset; int seek_whence = offset_base;
+                            off64_t position = offset; size_t nbytes_written = 0;
+                            auto nbytes_read = fsop::ingest(standard_input, [&](std::string_view chunk) {
+                                auto nbytes = absolute
+                                    ? write_at(chunk, position)
+                                    : file.write_all(chunk, seek_offset, seek_whence);
+                                seek_offset = 0; seek_whence = SEEK_CUR;
+                                position += nbytes; nbytes_written += nbytes;
+                            }, chunk_size);
+                            note_written(not absolute, offset, nbytes_written);
+                            file.commit();
+                            if(not quiet)
+                                std::cout << '\n' << program_name << ": wrote " << nbytes_written
+                                          << " of " << nbytes_read << " bytes to the file";
+                        }
+                        catch(std::system_error& error)
+                        {
+                            std::cerr << program_name << ": write failure: " << error.what();
+                        }
+
+                        if(not quiet)
+                            std::cout << "\n\n";
+                        continue;
+                    }
+
                     std::string content;
                     if (lbuf) getline(std::cin, content);
                     else
@@ -128,12 +340,29 @@ int fsop_cli::write(const argparse::types::result_map& args, std::string_view pr
                             std::istreambuf_iterator<char>()
                         );
 
+                    if(vectored)
+                    {
+                        pending_contents.push_back(std::move(content));
+                        pending_offsets .push_back(offset);
+                        if(not quiet)
+                            std::cout << '\n';
+                        continue;
+                    }
+
                     try
                     {
-                        auto nbytes_written = file.write(content, offset, offset_base);
+                        auto nbytes_written = buffered
+                            ? buffered->write(content, offset, offset_base)
+                            : absolute
+                            ? write_at(content, offset)
+                            : file.write_all(content, offset, offset_base);
+                        note_written(not absolute, offset, nbytes_written, buffered ? buffered->pending() : 0);
+                        if(not buffered) file.commit();
+                        // Buffered batches only reach the file once the buffer is flushed.
                         if(not quiet)
-                            std::cout << '\n' << program_name << ": wrote " << nbytes_written
-                                      << " of " << content.size() << " bytes to the file";
+                            std::cout << '\n' << program_name << (buffered ? ": buffered " : ": wrote ")
+                                      << nbytes_written << " of " << content.size() << " bytes "
+                                      << (buffered ? "for the file" : "to the file");
                     }
                     catch(std::system_error& error)
                     {
@@ -143,6 +372,66 @@ int fsop_cli::write(const argparse::types::result_map& args, std::string_view pr
                     if(not quiet)
                         std::cout << "\n\n";
                 }
+
+                if(buffered)
+                {
+                    try
+                    {
+                        // Batches coalesced in the buffer share a single commit.
+                        auto nbytes_flushed = buffered->flush();
+                        file.commit();
+                        if(not quiet)
+                            std::cout << program_name << ": flushed " << nbytes_flushed
+                                      << " pending byte(s) to the file\n\n";
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": write failure: " << error.what() << "\n\n";
+                    }
+                }
+
+                if(vectored)
+                {
+                    try
+                    {
+                        std::vector<size_t> nbytes_written;
+                        auto nwrites = fsop::write_batches(file, pending_offsets, pending_contents, nbytes_written);
+                        for(size_t index = 0; index < nbytes_written.size(); ++index)
+                            note_written(false, pending_offsets[index], nbytes_written[index]);
+                        file.commit();
+                        if(not quiet)
+                        {
+                            for(size_t index = 0; index < nbytes_written.size(); ++index)
+                                std::cout << program_name << ": write batch #" << index + 1 << ": wrote "
+                                          << nbytes_written[index] << " of " << pending_contents[index].size()
+                                          << " bytes to the file\n";
+                            std::cout << program_name << ": wrote " << nbytes_written.size()
+                                      << " batch(es) using " << nwrites << " vectored write(s)\n\n";
+                        }
+                    }
+                    catch(std::system_error& error)
+                    {
+                        std::cerr << program_name << ": write failure: " << error.what() << "\n\n";
+                    }
+                }
+
+                try
+                {
+                    // Content written since the last periodic sync is synced once all batches are done.
+                    file.settle();
+                }
+                catch(std::system_error& error)
+                {
+                    std::cerr << program_name << ": write failure: " << error.what() << "\n\n";
+                }
+
+                if(not vectored and not quiet)
+                {
+                    std::cout << program_name << ": write statistics: ";
+                    fsop::print_write_stats(std::cout, file.write_stats()) << "\n\n";
+                }
+
+                drop_written();
             }
             else
             {
@@ -8,11 +8,16 @@
  * @copyright Copyright (c) 2022
  */
 
+#include <chrono>       // std::chrono::milliseconds
+#include <string>       // std::string
 #include <iostream>     // std::cout, std::cin
+#include <stdexcept>    // std::invalid_argument
+#include <string_view>  // std::string_view
 
 #include "argparse.hpp" // Module for argument parsing.
 #include "fsop_cli.hpp" // Functions implementing CLI actions.
 
+#include "fsop/inspect.hpp"     // fsop::default_stat_fields, STATX_* constants
 #include "fsop/utilities.hpp"   // fsop::utils::*
 
 using namespace std::string_literals;
@@ -35,6 +40,31 @@ int main(int argc, const char** argv)
         return whences;
     };
 
+    // Groups of fields are given as a single comma-separated value, so that paths can follow.
+    auto to_stat_fields = [](const argparse::Optional::value_type& value) {
+        std::string_view _values = std::get<1>(value);
+        if(_values.empty()) return fsop::default_stat_fields;
+        unsigned int fields = 0;
+        while(true)
+        {
+            auto separator = _values.find(',');
+            auto valstr = _values.substr(0, separator);
+            if     (valstr == "identity") fields |= STATX_INO | STATX_NLINK;
+            else if(valstr == "owner"   ) fields |= STATX_UID | STATX_GID;
+            else if(valstr == "mode"    ) fields |= STATX_TYPE | STATX_MODE;
+            else if(valstr == "size"    ) fields |= STATX_SIZE | STATX_BLOCKS;
+            else if(valstr == "times"   ) fields |= STATX_ATIME | STATX_CTIME | STATX_MTIME;
+            else if(valstr == "birth"   ) fields |= STATX_BTIME;
+            else throw std::invalid_argument(
+                "invalid group '" + std::string(valstr) + "' for --fields "
+                "(choose from birth, identity, mode, owner, size, times)"
+            );
+            if(separator == std::string_view::npos) break;
+            _values.remove_prefix(separator + 1);
+        }
+        return fields;
+    };
+
     argparse::Parser parser {
         name = argv[0],
         description = (
@@ -71,7 +101,9 @@ int main(int argc, const char** argv)
             "indicating read, write, execute or no permission for the corresponding permission group, or the string "
             "separating permission group letters (u, g and o) with permissions (r, w or x) with a + symbol (e.g.: "
             "ug+rw to grant read and write permission to user and the group)\n\n"
-            "the overwrite mode works by unlinking the file and recreating it, so hard links might be lost as a result"
+            "the overwrite mode works by unlinking the file and recreating it, so hard links might be lost as a result\n\n"
+            "regular files can be created with an initial size, allocated upfront (preallocate), left as a hole "
+            "(sparse) or filled with zeros (zero), to avoid fragmentation from many extending writes later"
         )
     };
     create_parser.add_arguments(
@@ -101,6 +133,20 @@ int main(int argc, const char** argv)
             transform = [](const argparse::Optional::value_type& value) {
                 return fsop::utils::parse_permissions(std::get<1>(value));
             }
+        },
+        argparse::Optional
+        {
+            name = "size", alias = "s", default_value = "0"s,
+            help = "initial size of the regular file, in bytes",
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
+        },
+        argparse::Optional
+        {
+            name = "allocation", alias = "a", default_value = "preallocate"s,
+            help = "how the initial size of the regular file is allocated",
+            choices = std::vector <std::string_view> { "preallocate", "sparse", "zero" }
         }
     );
 
@@ -126,6 +172,36 @@ int main(int argc, const char** argv)
             name = "pipe", alias = "p",
             help = "read (and write?) content from a pipe (possibly unnamed)",
         },
+        argparse::Switch
+        {
+            name = "splice", alias = "S",
+            help = (
+                "with an unnamed pipe, move STDIN through the pipe to STDOUT within "
+                "the kernel (splice), and report the throughput reached"
+            )
+        },
+        argparse::Optional
+        {
+            name = "buffer-size", alias = "z", default_value = "65536"s,
+            help = (
+                "watermark of the buffer coalescing line-oriented writes (with an unnamed "
+                "pipe, and with --line-buffered), in bytes"
+            ),
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
+        },
+        argparse::Optional
+        {
+            name = "pipe-size", alias = "P", default_value = "0"s,
+            help = (
+                "capacity to request for the pipe buffer (named or unnamed), in bytes "
+                "(0 keeps the system default)"
+            ),
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
+        },
         argparse::Optional
         {
             name = "offset", alias = "b", arity = argparse::Argument::ZERO_OR_MORE,
@@ -145,6 +221,104 @@ int main(int argc, const char** argv)
             arity = argparse::Argument::ZERO_OR_MORE,
             help = "number of bytes to read",
             transform = argparse::transforms::to_integral<size_t>,
+        },
+        argparse::Switch
+        {
+            name = "mmap", alias = "m",
+            help = "serve reads from a memory mapping of the file (regular files only)"
+        },
+        argparse::Switch
+        {
+            name = "absolute", alias = "a",
+            help = (
+                "treat offsets as absolute positions from the beginning, and read via "
+                "positional reads without moving the file offset (regular files only)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "vectored", alias = "V",
+            help = (
+                "read batches via vectored reads coalescing adjacent batches, and emit "
+                "content via vectored writes (implies --absolute)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "uring", alias = "U",
+            help = (
+                "submit all batches asynchronously via io_uring, falling back to synchronous "
+                "reads if unavailable (implies --absolute)"
+            )
+        },
+        argparse::Optional
+        {
+            name = "queue-depth", alias = "Q", default_value = "64"s,
+            help = "maximum number of reads in flight with --uring",
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<unsigned>(std::stoul(std::get<1>(value)));
+            }
+        },
+        argparse::Switch
+        {
+            name = "stream", alias = "s",
+            help = "stream content to STDOUT in fixed-size chunks through a reused buffer (bounded memory)"
+        },
+        argparse::Switch
+        {
+            name = "sparse", alias = "H",
+            help = (
+                "walk data extents via SEEK_DATA/SEEK_HOLE, reading only data and emitting "
+                "zeros for holes without I/O (regular files only, implies --absolute)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "extent-map", alias = "E",
+            help = "report the map of data extents and holes instead of content (regular files only, implies --absolute)"
+        },
+        argparse::Switch
+        {
+            name = "advise", alias = "F",
+            help = (
+                "pass the access pattern of the batches (sequential or random) to the kernel "
+                "via posix_fadvise/readahead before reading (regular files only)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "drop-cache", alias = "X",
+            help = (
+                "drop pages read from the page cache once done (progressively with --stream), so "
+                "that large scans do not evict the working set (regular files only)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "direct", alias = "O",
+            help = (
+                "read via direct I/O (O_DIRECT) through buffers aligned to the logical block size, "
+                "bypassing the page cache (regular files only, implies --absolute)"
+            )
+        },
+        argparse::Optional
+        {
+            name = "workers", alias = "W", default_value = "1"s,
+            help = (
+                "number of threads reading chunks of each batch in parallel via positional "
+                "reads, with output kept in order (regular files only, implies --absolute if > 1)"
+            ),
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<unsigned>(std::stoul(std::get<1>(value)));
+            }
+        },
+        argparse::Optional
+        {
+            name = "chunk-size", alias = "k", default_value = "65536"s,
+            help = "size of chunks used with --stream, --sparse, --workers and --direct, in bytes",
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
         }
     );
 
@@ -172,6 +346,36 @@ int main(int argc, const char** argv)
             help = "write (and read?) content to a pipe (possibly unnamed)",
         },
         argparse::Switch
+        {
+            name = "splice", alias = "S",
+            help = (
+                "with an unnamed pipe, move STDIN through the pipe to STDOUT within "
+                "the kernel (splice), and report the throughput reached"
+            )
+        },
+        argparse::Optional
+        {
+            name = "buffer-size", alias = "z", default_value = "65536"s,
+            help = (
+                "watermark of the buffer coalescing line-oriented writes (with an unnamed "
+                "pipe, and with --line-buffered), in bytes"
+            ),
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
+        },
+        argparse::Optional
+        {
+            name = "pipe-size", alias = "P", default_value = "0"s,
+            help = (
+                "capacity to request for the pipe buffer (named or unnamed), in bytes "
+                "(0 keeps the system default)"
+            ),
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
+        },
+        argparse::Switch
         {
             name = "line-buffered", alias = "lbuf",
             help = "read STDIN in line-buffered manner",
@@ -198,6 +402,103 @@ int main(int argc, const char** argv)
         {
             name = "truncate", alias = "t",
             help = "truncate file contents prior to writing"
+        },
+        argparse::Switch
+        {
+            name = "absolute", alias = "a",
+            help = (
+                "treat offsets as absolute positions from the beginning, and write via "
+                "positional writes without moving the file offset (regular files only)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "vectored", alias = "V",
+            help = (
+                "defer batches and write them via vectored writes coalescing "
+                "adjacent batches (implies --absolute)"
+            )
+        },
+        argparse::Optional
+        {
+            name = "durability", alias = "D", default_value = "none"s,
+            help = (
+                "durability of written content: none (left to the kernel), periodic (synced per "
+                "--sync-bytes or --sync-interval) or batch (synced per batch, shared across batches)"
+            ),
+            choices = std::vector<std::string_view> { "none", "periodic", "batch" }
+        },
+        argparse::Optional
+        {
+            name = "sync-bytes", alias = "sb", default_value = "0"s,
+            help = "with periodic durability, sync after this many bytes are written (0 to disable)",
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
+        },
+        argparse::Optional
+        {
+            name = "sync-interval", alias = "si", default_value = "0"s,
+            help = "with periodic durability, sync once this many milliseconds pass since the last sync (0 to disable)",
+            transform = [](const argparse::Optional::value_type& value) {
+                return std::chrono::milliseconds{ std::stoll(std::get<1>(value)) };
+            }
+        },
+        argparse::Switch
+        {
+            name = "stream", alias = "s",
+            help = (
+                "ingest STDIN in fixed-size chunks through two alternating buffers, "
+                "writing one while the other fills (bounded memory)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "drop-cache", alias = "X",
+            help = (
+                "sync written content and drop the pages of the file from the page cache "
+                "once done, so that bulk loads do not evict the working set (regular files only)"
+            )
+        },
+        argparse::Switch
+        {
+            name = "direct", alias = "O",
+            help = (
+                "write via direct I/O (O_DIRECT) through buffers aligned to the logical block size, "
+                "bypassing the page cache (regular files only, implies --absolute)"
+            )
+        },
+        argparse::Optional
+        {
+            name = "source", alias = "i", default_value = ""s,
+            help = (
+                "read content from this regular file instead of STDIN, and write it via "
+                "parallel positional writes (implies --absolute)"
+            )
+        },
+        argparse::Optional
+        {
+            name = "workers", alias = "W", default_value = "1"s,
+            help = (
+                "number of threads writing chunks in parallel via positional writes, when the "
+                "size of the input is known (with --source, or STDIN redirected from a regular file)"
+            ),
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<unsigned>(std::stoul(std::get<1>(value)));
+            }
+        },
+        argparse::Switch
+        {
+            name = "preallocate", alias = "L",
+            help = "with parallel writes, allocate the written range via fallocate beforehand"
+        },
+        argparse::Optional
+        {
+            name = "chunk-size", alias = "k", default_value = "1048576"s,
+            help = "size of chunks used with --stream, parallel writes and --direct, in bytes",
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<size_t>(std::stoull(std::get<1>(value)));
+            }
         }
     );
 
@@ -216,6 +517,33 @@ int main(int argc, const char** argv)
         {
             name = "follow-symlinks", alias = "l",
             help = "resolve symbolic links and inspect the resolved path instead"
+        },
+        argparse::Optional
+        {
+            name = "fields", alias = "f", default_value = ""s,
+            help = (
+                "comma-separated groups of fields to retrieve and display, from identity, owner, "
+                "mode, size, times and birth (default: all)"
+            ),
+            transform = to_stat_fields
+        },
+        argparse::Switch
+        {
+            name = "cached", alias = "c",
+            help = "return attributes cached locally without syncing with the filesystem (fast, possibly stale)"
+        },
+        argparse::Switch
+        {
+            name = "extents", alias = "e",
+            help = "also map data and holes of regular files (opens each file, and seeks over its extents)"
+        },
+        argparse::Optional
+        {
+            name = "workers", alias = "W", default_value = "1"s,
+            help = "number of threads inspecting paths concurrently (output stays in the order of paths)",
+            transform = [](const argparse::Optional::value_type& value) {
+                return static_cast<unsigned>(std::stoul(std::get<1>(value)));
+            }
         }
     );
 